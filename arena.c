@@ -0,0 +1,95 @@
+/*
+* Project: Implementacia prekladaca imperativneho jazyka IFJ2024
+*
+* @author: Jakub Hrdlicka <xhrdli18>
+*
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "arena.h"
+
+// Size of one block, bigger allocations get block of their own
+#define ARENA_BLOCK_SIZE (1 << 20)
+
+// Alignment of every allocation
+#define ARENA_ALIGN 16
+
+// Block of memory, allocations are bumped from its data
+typedef struct arena_block {
+    struct arena_block *prev;
+    size_t size;
+    size_t used;
+    char data[];
+} arena_block_t;
+
+// Initialize empty arena
+void arena_init(arena_t *arena, diag_t *diag){
+    arena->top = NULL;
+    arena->alloc_count = 0;
+    arena->block_count = 0;
+    arena->bytes = 0;
+    arena->diag = diag;
+}
+
+// Allocate new block with at least size usable bytes
+void arena_new_block(arena_t *arena, size_t size){
+    if (size < ARENA_BLOCK_SIZE){
+        size = ARENA_BLOCK_SIZE;
+    }
+    arena_block_t *block = (arena_block_t *)malloc(sizeof(arena_block_t) + size + ARENA_ALIGN);
+    if (block == NULL){
+        diag_raise(arena->diag, 99, "Error: Allocation failed");
+    }
+    block->prev = arena->top;
+    block->size = size + ARENA_ALIGN;
+    block->used = 0;
+    arena->top = block;
+    arena->block_count++;
+}
+
+// Allocate memory that lives until arena_free
+void *arena_alloc(arena_t *arena, size_t size){
+    arena_block_t *top = arena->top;
+    if (top != NULL){
+        uintptr_t start = (uintptr_t)(top->data + top->used);
+        uintptr_t aligned = (start + ARENA_ALIGN - 1) & ~(uintptr_t)(ARENA_ALIGN - 1);
+        size_t used = top->used + (aligned - start) + size;
+        if (used <= top->size){
+            top->used = used;
+            arena->alloc_count++;
+            arena->bytes += size;
+            return (void *)aligned;
+        }
+    }
+
+    // Current block is full, space for alignment is reserved in new block
+    arena_new_block(arena, size);
+    return arena_alloc(arena, size);
+}
+
+// Copy text of given length into arena
+char *arena_strndup(arena_t *arena, const char *text, size_t length){
+    char *copy = (char *)arena_alloc(arena, length + 1);
+    memcpy(copy, text, length);
+    copy[length] = '\0';
+    return copy;
+}
+
+// Print number of allocations served by arena
+void arena_report(arena_t *arena){
+    fprintf(stderr, "arena: %zu allocations (%zu bytes) served from %zu blocks\n",
+            arena->alloc_count, arena->bytes, arena->block_count);
+}
+
+// Release everything allocated from arena
+void arena_free(arena_t *arena){
+    while (arena->top != NULL){
+        arena_block_t *prev = arena->top->prev;
+        free(arena->top);
+        arena->top = prev;
+    }
+    arena_init(arena, arena->diag);
+}
\ No newline at end of file
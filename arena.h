@@ -0,0 +1,38 @@
+/*
+* Project: Implementacia prekladaca imperativneho jazyka IFJ2024
+*
+* @author: Jakub Hrdlicka <xhrdli18>
+*
+*/
+
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stddef.h>
+#include "diag.h"
+
+// Arena of one compilation, zero initialized arena is empty
+typedef struct arena {
+    struct arena_block *top;    // newest block, older blocks are linked through prev
+    size_t alloc_count;         // statistics for arena_report
+    size_t block_count;
+    size_t bytes;
+    diag_t *diag;               // allocation failure is reported here
+} arena_t;
+
+// Initialize empty arena
+void arena_init(arena_t *arena, diag_t *diag);
+
+// Allocate memory that lives until arena_free, never returns NULL (raises error 99)
+void *arena_alloc(arena_t *arena, size_t size);
+
+// Copy text of given length into arena and terminate it with NUL
+char *arena_strndup(arena_t *arena, const char *text, size_t length);
+
+// Print number of allocations served by arena to stderr
+void arena_report(arena_t *arena);
+
+// Release everything allocated from arena at once
+void arena_free(arena_t *arena);
+
+#endif
@@ -9,91 +9,182 @@
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
+#include <inttypes.h>
 
 #include "ast.h"
 
 
+// Reallocates array to new capacity, raises error on failure
+void *ast_grow(AST *ast, void *array, size_t capacity, size_t size){
+    array = realloc(array, capacity * size);
+    if (array == NULL) {
+        diag_raise(ast->diag, 99, "Error allocating memory for AST");
+    }
+    return array;
+}
+
 // Creates and initializes AST
 // Returns pointer to the newly created AST
-AST *create_ast() {
-    AST *ast = malloc(sizeof(AST));
+AST *create_ast(diag_t *diag) {
+    AST *ast = calloc(1, sizeof(AST));
     if (ast == NULL) {
-        fprintf(stderr, "Error allocating memory for AST\n");
-        exit(99);
+        diag_raise(diag, 99, "Error allocating memory for AST");
     }
-    // Initializes to default values
-    ast->active = NULL;
-    ast->currentLine = NULL;
-    ast->root = NULL;
+    ast->diag = diag;
+    // Node 0 is reserved for AST_NONE
+    ast->count = 1;
+    ast->root = create_node(ast, node_block, NULL);
     return ast;
 }
 
-// Creates new node, saves "token" as its value
-// and moves ast->active to point to the new node
-void create_node(token_t *token, AST *ast){
-    ASTNode *node = malloc(sizeof(ASTNode)); // allocating for node
-    if (node == NULL) {
-        fprintf(stderr, "Error allocating memory for ASTNode\n");
-        exit(99);
-    }
-    
-    node->next = NULL;    // right child
-    node->newLine = NULL; // left child
-    node->token = token;
-
-    // If theres no active node => tree is empty
-    // Sets new node as root
-    if (ast->active == NULL) {
-        ast->root = node;
-        ast->currentLine = node;
-    }
-    // Makes current active node point to new node
-    else {
-        ast->active->next = node;
+// Creates new node of "type", saves "token" as its payload
+// Returns index of the new node, it has no children or siblings
+ast_index_t create_node(AST *ast, ast_node_type_t type, token_t *token){
+    // Arrays grow together, indexes of nodes stay valid
+    if (ast->count >= ast->capacity){
+        ast->capacity = ast->capacity == 0 ? 1024 : ast->capacity * 2;
+        ast->type = ast_grow(ast, ast->type, ast->capacity, sizeof(uint8_t));
+        ast->data_type = ast_grow(ast, ast->data_type, ast->capacity, sizeof(uint8_t));
+        ast->constant = ast_grow(ast, ast->constant, ast->capacity, sizeof(uint8_t));
+        ast->child = ast_grow(ast, ast->child, ast->capacity, sizeof(ast_index_t));
+        ast->next = ast_grow(ast, ast->next, ast->capacity, sizeof(ast_index_t));
+        ast->payload = ast_grow(ast, ast->payload, ast->capacity, sizeof(ast_payload_t));
+        ast->symbol = ast_grow(ast, ast->symbol, ast->capacity, sizeof(struct ht_item *));
     }
-    // Moves the active pointer to new node
-    ast->active = node;
+
+    ast_index_t node = ast->count++;
+    ast->type[node] = type;
+    ast->data_type[node] = kind_none;
+    ast->constant[node] = false;
+    ast->child[node] = AST_NONE;
+    ast->next[node] = AST_NONE;
+    ast->payload[node].token = token;
+    ast->symbol[node] = NULL;
+    return node;
 }
 
-// Moves ast->active to next node and returns value of ast->active
-ASTNode *next_node(AST *ast) {
-    // If tree was uninitialized
-    if (ast->active == NULL){
-        ast->active = ast->root;
+// Starts empty list of children of "parent"
+ast_list_t ast_list(ast_index_t parent){
+    ast_list_t list = {parent, AST_NONE};
+    return list;
+}
+
+// Appends "node" as last child of the list parent
+void ast_append(AST *ast, ast_list_t *list, ast_index_t node){
+    if (list->last == AST_NONE){
+        ast->child[list->parent] = node;
     }
     else {
-        // Moves the pointer
-        ast->active = ast->active->next;
+        ast->next[list->last] = node;
     }
-    
-    return ast->active;
+    list->last = node;
 }
 
-// Prints whole tree data with type
-void print_ast(AST *ast){
-    ast->active = ast->root;
+// Records function node into index of functions
+// Semantics declares all functions from it before walking the code
+void ast_add_function(AST *ast, ast_index_t node){
+    if (ast->function_count == ast->function_capacity){
+        ast->function_capacity = ast->function_capacity == 0 ? 64 : ast->function_capacity * 2;
+        ast->functions = ast_grow(ast, ast->functions, ast->function_capacity, sizeof(ast_index_t));
+    }
+    ast->functions[ast->function_count++] = node;
+}
 
-    while(ast->active != NULL && ast->active->token->type != eof_token){
-        printf("%s\t\t", ast->active->token->data);
-        printf("type: %d\n", ast->active->token->type);
-        next_node(ast);
+// Appends token to the expression being parsed
+void ast_postfix_push(AST *ast, token_t *token){
+    if (ast->postfix_count == ast->postfix_capacity){
+        ast->postfix_capacity = ast->postfix_capacity == 0 ? 1024 : ast->postfix_capacity * 2;
+        ast->postfix = ast_grow(ast, ast->postfix, ast->postfix_capacity, sizeof(token_t *));
+        ast->postfix_symbol = ast_grow(ast, ast->postfix_symbol, ast->postfix_capacity, sizeof(struct ht_item *));
     }
+    ast->postfix_symbol[ast->postfix_count] = NULL;
+    ast->postfix[ast->postfix_count++] = token;
 }
 
-// Frees the whole tree
-void destroy_ast(AST *ast){
-    ast->active = ast->root;
-    ASTNode *tmp = NULL;
+// Creates expression node from tokens pushed since last expression
+// Tokens of all expressions lie one after another in one array
+ast_index_t create_expression_node(AST *ast){
+    ast_index_t node = create_node(ast, node_expression, NULL);
+    ast->payload[node].postfix.start = ast->postfix_start;
+    ast->payload[node].postfix.count = ast->postfix_count - ast->postfix_start;
+    ast->postfix_start = ast->postfix_count;
+    return node;
+}
+
+// Returns n-th child of node, AST_NONE if there are less children
+ast_index_t ast_child(AST *ast, ast_index_t node, int n){
+    ast_index_t child = ast->child[node];
+    while (n-- > 0 && child != AST_NONE){
+        child = ast->next[child];
+    }
+    return child;
+}
+
+// Returns last child of node, AST_NONE if node has no children
+ast_index_t ast_last_child(AST *ast, ast_index_t node){
+    ast_index_t child = ast->child[node];
+    while (child != AST_NONE && ast->next[child] != AST_NONE){
+        child = ast->next[child];
+    }
+    return child;
+}
+
+// Names of node types for printing
+static const char *node_type_names[] = {
+    "block", "function", "param", "var_decl", "if", "while", "return", "call", "assignment", "expression"
+};
+
+// Prints token, literals have no text and are printed by their values
+void print_token(token_t *token){
+    if (token->type == int_token){
+        printf(" %" PRId64, token->int_value);
+    }
+    else if (token->type == float_token){
+        printf(" %g", token->float_value);
+    }
+    else if (token->type == string_token){
+        printf(" %.*s", (int)token->text_length, token->text);
+    }
+    else {
+        printf(" %s", token->data);
+    }
+}
 
-    // Frees all nodes
-    while(ast->active != NULL && ast->active->token->type != eof_token){
-        tmp = ast->active;
-        next_node(ast);
-        free(tmp->token->data);
-        free(tmp->token);
-        free(tmp);
+// Prints node with all its children, children are indented
+void print_node(AST *ast, ast_index_t node, int depth){
+    printf("%*s%s", depth * 4, "", node_type_names[ast->type[node]]);
+    if (ast->type[node] == node_expression){
+        for (uint32_t i = 0; i < ast->payload[node].postfix.count; i++){
+            print_token(ast_postfix(ast, node, i));
+        }
     }
+    else if (ast->payload[node].token != NULL){
+        print_token(ast->payload[node].token);
+    }
+    printf("\n");
 
-    // and then the structure for tree itself
+    for (ast_index_t child = ast->child[node]; child != AST_NONE; child = ast->next[child]){
+        print_node(ast, child, depth + 1);
+    }
+}
+
+// Prints whole tree with type and data of each node
+void print_ast(AST *ast){
+    print_node(ast, ast->root, 0);
+}
+
+// Frees the whole tree
+void destroy_ast(AST *ast){
+    // tokens are allocated in arena and released with it
+    free(ast->type);
+    free(ast->data_type);
+    free(ast->constant);
+    free(ast->child);
+    free(ast->next);
+    free(ast->payload);
+    free(ast->symbol);
+    free(ast->postfix);
+    free(ast->postfix_symbol);
+    free(ast->functions);
     free(ast);
 }
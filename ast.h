@@ -9,35 +9,115 @@
 #ifndef AST_H
 #define AST_H
 
+#include <stdbool.h>
+#include <stdint.h>
 #include "token.h"
+#include "diag.h"
 
-// AST nodes
-typedef struct Node{
-    struct Node *next;  // right
-    struct Node *newLine; // left
-    token_t *token;
-} ASTNode;
+// Types of AST nodes, children are listed in order
+typedef enum {
+    node_block,         // statements of block, root of AST is block of top level statements
+    node_function,      // pub fn ID ( <param>... ) type <block>
+    node_param,         // ID : type
+    node_var_decl,      // var/const ID [: type] = <value>
+    node_if,            // if ( <expression> ) [|binding|] <block> else <block>
+    node_while,         // while ( <expression> ) [|binding|] <block>
+    node_return,        // return [<expression>]
+    node_call,          // ID ( <expression>... ), arguments are single terms
+    node_assignment,    // ID = <value>
+    node_expression     // operands and operators in postfix order, has no children
+} ast_node_type_t;
 
-// Structure representing AST with extra helpful infos
+// Symbol of symtable (hashtable.h), resolved by semantic analysis
+struct ht_item;
+
+// Nodes are referenced by index into arrays of AST, 0 is no node
+typedef uint32_t ast_index_t;
+#define AST_NONE 0
+
+// Data of node, depends on its type
+typedef union {
+    token_t *token;         // name of function, parameter, variable or called function, binding of if/while
+    struct {
+        uint32_t start;     // index of first token in postfix array of AST
+        uint32_t count;     // number of tokens
+    } postfix;              // tokens of expression
+} ast_payload_t;
+
+// Structure representing AST, nodes are stored in parallel arrays
 typedef struct {
-    ASTNode *root;
-    ASTNode *active;
-    ASTNode *currentLine;
+    uint8_t *type;          // ast_node_type_t of node
+    uint8_t *data_type;     // token_kind_t of declared type, kind_none if missing
+    uint8_t *constant;      // variable declared with const
+    ast_index_t *child;     // first child
+    ast_index_t *next;      // next sibling
+    ast_payload_t *payload;
+    struct ht_item **symbol; // declared, assigned or called symbol, NULL until semantic analysis and for built-in calls
+    uint32_t count;         // number of nodes, including unused node 0
+    uint32_t capacity;
+
+    token_t **postfix;      // tokens of all expressions in postfix order
+    struct ht_item **postfix_symbol; // symbol of identifier in postfix, NULL for other tokens
+    uint32_t postfix_count;
+    uint32_t postfix_capacity;
+    uint32_t postfix_start; // first token of expression being parsed
+
+    ast_index_t root;       // block of top level statements
+
+    ast_index_t *functions; // function nodes in order of definition, signatures are complete
+    uint32_t function_count;
+    uint32_t function_capacity;
+
+    diag_t *diag;           // allocation failure is reported here
 } AST;
 
+// List of children that are appended one after another
+typedef struct {
+    ast_index_t parent;
+    ast_index_t last;
+} ast_list_t;
+
 // Creates and initializes new AST
-AST *create_ast();
+AST *create_ast(diag_t *diag);
+
+// Creates new node of given type with token as payload, returns its index
+ast_index_t create_node(AST *ast, ast_node_type_t type, token_t *token);
+
+// Starts list of children of parent
+ast_list_t ast_list(ast_index_t parent);
+
+// Appends node at the end of the list
+void ast_append(AST *ast, ast_list_t *list, ast_index_t node);
+
+// Records function whose header (name, parameters, return type) was parsed
+void ast_add_function(AST *ast, ast_index_t node);
+
+// Appends token to expression being parsed
+void ast_postfix_push(AST *ast, token_t *token);
+
+// Creates expression node from tokens pushed since last expression
+ast_index_t create_expression_node(AST *ast);
+
+// Returns i-th token of expression node
+static inline token_t *ast_postfix(AST *ast, ast_index_t node, uint32_t i){
+    return ast->postfix[ast->payload[node].postfix.start + i];
+}
+
+// Returns symbol of i-th token of expression node
+static inline struct ht_item *ast_postfix_symbol(AST *ast, ast_index_t node, uint32_t i){
+    return ast->postfix_symbol[ast->payload[node].postfix.start + i];
+}
 
-// Creates new node with token as data and saves it to ast
-void create_node(token_t *token, AST *ast);
+// Returns n-th child of node (counting from 0), AST_NONE if there is not any
+ast_index_t ast_child(AST *ast, ast_index_t node, int n);
 
-// Moves the active pointer to next node
-ASTNode *next_node(AST *ast);
+// Returns last child of node, AST_NONE if there is not any
+ast_index_t ast_last_child(AST *ast, ast_index_t node);
 
-// Prints out ast with data and type of each node
+// Prints out ast with type and data of each node
 void print_ast(AST *ast);
 
 // Destroys ast and frees allocated memory
 void destroy_ast(AST *ast);
 
-#endif //AST_H
\ No newline at end of file
+#endif //AST_H
@@ -0,0 +1,50 @@
+/*
+* Project: Implementace překladače imperativního jazyka IFJ24
+*
+* @author: Jakub Lůčný <xlucnyj00>
+* @author: Martin Ševčík <xsevcim00>
+*
+*/
+
+#include <stdlib.h>
+
+#include "builtins.h"
+
+
+// Types of parameters, sym_void_type indicating that it can take any type of argument
+static const symtable_type_t any_param[] = {sym_void_type};
+static const symtable_type_t int_param[] = {sym_int_type};
+static const symtable_type_t float_param[] = {sym_float_type};
+static const symtable_type_t string_param[] = {sym_string_type};
+static const symtable_type_t string_string_params[] = {sym_string_type, sym_string_type};
+static const symtable_type_t string_int_params[] = {sym_string_type, sym_int_type};
+static const symtable_type_t substring_params[] = {sym_string_type, sym_int_type, sym_int_type};
+
+// Item of built-in function, built-in functions dont have to be used
+#define BUILTIN(index, name, count, param_types, ret) \
+    {INTERN_BUILTIN_FIRST + index, name, sym_func_type, sym_const, true, true, count, param_types, ret}
+
+// Signatures of built-in functions in order of their ids
+static const ht_item_t builtin_functions[BUILTIN_COUNT] = {
+    BUILTIN(0, "ifj$readstr", 0, NULL, sym_nullable_string_type),               // () ?[]u8
+    BUILTIN(1, "ifj$readi32", 0, NULL, sym_nullable_int_type),                  // () ?i32
+    BUILTIN(2, "ifj$readf64", 0, NULL, sym_nullable_float_type),                // () ?f64
+    BUILTIN(3, "ifj$write", 1, any_param, sym_void_type),                       // (term) void
+    BUILTIN(4, "ifj$i2f", 1, int_param, sym_float_type),                        // (i32) f64
+    BUILTIN(5, "ifj$f2i", 1, float_param, sym_int_type),                        // (f64) i32
+    BUILTIN(6, "ifj$string", 1, string_param, sym_string_type),                 // ([]u8) []u8
+    BUILTIN(7, "ifj$length", 1, string_param, sym_int_type),                    // ([]u8) i32
+    BUILTIN(8, "ifj$concat", 2, string_string_params, sym_string_type),         // ([]u8, []u8) []u8
+    BUILTIN(9, "ifj$substring", 3, substring_params, sym_nullable_string_type), // ([]u8, i32, i32) ?[]u8
+    BUILTIN(10, "ifj$strcmp", 2, string_string_params, sym_int_type),           // ([]u8, []u8) i32
+    BUILTIN(11, "ifj$ord", 2, string_int_params, sym_int_type),                 // ([]u8, i32) i32
+    BUILTIN(12, "ifj$chr", 1, int_param, sym_string_type)                       // (i32) []u8
+};
+
+// Signature of built-in function with given id
+const ht_item_t *builtin_function(int id){
+    if (id < INTERN_BUILTIN_FIRST || id >= INTERN_BUILTIN_FIRST + BUILTIN_COUNT){
+        return NULL;
+    }
+    return &builtin_functions[id - INTERN_BUILTIN_FIRST];
+}
\ No newline at end of file
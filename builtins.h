@@ -0,0 +1,23 @@
+/*
+* Project: Implementace překladače imperativního jazyka IFJ24
+*
+* @author: Jakub Lůčný <xlucnyj00>
+* @author: Martin Ševčík <xsevcim00>
+*
+*/
+
+#ifndef BUILTINS_H
+#define BUILTINS_H
+
+#include "hashtable.h"
+
+// Number of built-in functions
+#define BUILTIN_COUNT 13
+
+// Built-in functions are interned right after "_", so their ids are known without lookup
+#define INTERN_BUILTIN_FIRST 1
+
+// Signature of built-in function with given id, NULL if it is not a built-in function
+const ht_item_t *builtin_function(int id);
+
+#endif
\ No newline at end of file
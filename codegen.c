@@ -9,475 +9,649 @@
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
+#include <math.h>
+#include <inttypes.h>
 
 #include "ast.h"
 #include "codegen.h"
-
-
-// Represents number of variable declaration in current function block 
-// (used for generating code to avoid variable redeclaration) 
-int global_decl_cnt = 0;
+#include "hashtable.h"
+#include "intern.h"
+#include "ir.h"
+#include "arena.h"
+
+
+// Type of value on the stack of expression, known at compile time
+// Only i32 symbols and literals are trusted, f64 variable may hold int at run time
+typedef enum {
+    value_unknown,
+    value_int,
+    value_float,
+    value_bool
+} value_type_t;
+
+// What is known about postfix token of expression being generated
+typedef enum {
+    expr_type_mask  = 0x03,  // value_type_t of value the token leaves on the stack
+    expr_dynamic    = 0x04,  // operand types are checked and converted at run time
+    expr_const      = 0x08,  // literal or operation on constants, value is known
+    expr_widen_left = 0x10,  // left int operand is converted to float at run time
+    expr_widen_right = 0x20, // right int operand is converted to float at run time
+    expr_nonzero    = 0x40,  // divisor is non-zero constant, no check of division by zero
+    expr_folded     = 0x80   // constant is folded into operation using it, it is not pushed
+} expr_info_t;
+
+// State of code generation of one compilation
+typedef struct codegen {
+    // Counters of unique labels
+    int bi_operations_counter;
+    int div_counter;
+    int if_label_counter;
+    int while_label_counter;
+    // Locals are defined at the beginning of function, ones with the same name are renamed
+    // Both arrays are indexed by id of name, name_uses is valid if name_function is current function
+    uint32_t *name_function;
+    uint32_t *name_uses;
+    uint32_t function_cnt;
+    // Info about tokens of expression being generated and stack for finding it, kept in arena
+    uint8_t *expr_info;
+    ir_operand_t *expr_value;   // value of constant
+    uint32_t *expr_stack;
+    uint32_t expr_capacity;
+    arena_t *arena;
+    ir_code_t *code;    // instructions of function being generated
+    emitter_t *out;     // finished functions are printed here
+    diag_t *diag;       // allocation failure is reported here
+} codegen_t;
 
 // Function declarations:
-void generate_initial_values();
-void generate_code(AST *ast);
-void generate_code_for_line(ASTNode *token_node, AST *ast);
-void generate_expression(ASTNode *token_node, AST *ast);
-void generate_if_statement(ASTNode *token_node, AST *ast);
-void generate_while_loop(ASTNode *token_node, AST *ast);
-void generate_variable_declaration(ASTNode *token_node, AST *ast);
-void generate_assignment_or_expression(ASTNode *token_node, AST *ast);
-void generate_expression_assignment(char *identifier, ASTNode *token_node, AST *ast);
-void generate_function_call_assignment(char *identifier, ASTNode *function_call_node, AST *ast);
-void generate_string_assignment(char *identifier, char *string);
-void generate_function_call(char *function_name, ASTNode *token_node, AST *ast);
-char *escape_string(const char *input);
-void generate_function_definition(ASTNode *token_node, AST *ast);
-void generate_function_return(ASTNode *token_node, AST *ast);
-void generate_builtin_functions();
+void generate_initial_values(codegen_t *gen);
+void generate_code(compiler_t *compiler, emitter_t *out);
+void generate_flush(codegen_t *gen);
+void generate_block(AST *ast, ast_index_t node, codegen_t *gen);
+void generate_expression(AST *ast, ast_index_t node, codegen_t *gen);
+void infer_expression_types(AST *ast, ast_index_t node, codegen_t *gen);
+uint8_t infer_operation(token_t *token, uint32_t left, uint32_t right, uint32_t position, codegen_t *gen);
+bool fold_operation(token_kind_t kind, ir_operand_t left, ir_operand_t right, ir_operand_t *result);
+void widen_constant(ir_operand_t *value);
+void generate_if_statement(AST *ast, ast_index_t node, codegen_t *gen);
+void generate_while_loop(AST *ast, ast_index_t node, codegen_t *gen);
+void generate_variable_declaration(AST *ast, ast_index_t node, codegen_t *gen);
+void generate_assignment_or_expression(AST *ast, ast_index_t node, codegen_t *gen);
+void generate_expression_assignment(AST *ast, char *identifier, ast_index_t node, codegen_t *gen);
+void generate_function_call_assignment(AST *ast, char *identifier, ast_index_t call_node, codegen_t *gen);
+void generate_string_assignment(char *identifier, token_t *string, codegen_t *gen);
+void generate_function_call(AST *ast, char *function_name, ast_index_t call_node, codegen_t *gen);
+void generate_function_definition(AST *ast, ast_index_t node, codegen_t *gen);
+void generate_local_definitions(AST *ast, ast_index_t node, codegen_t *gen);
+void generate_local_definition(ht_item_t *symbol, codegen_t *gen);
+void generate_function_return(AST *ast, ast_index_t node, codegen_t *gen);
+void generate_builtin_functions(codegen_t *gen);
 
 
 // Generates code to create variables in GF, frame for 'main' and 'call main'
-void generate_initial_values(){
-    printf(".IFJcode24\n");
-
+void generate_initial_values(codegen_t *gen){
     // condition result for if/while statements
-    printf("DEFVAR GF@__condition_bool\n");
+    ir_add1(gen->code, IR_DEFVAR, ir_gf("__condition_bool"));
 
     // variables for type checking and conversion
-    printf("DEFVAR GF@__type_conver_var1\n");
-    printf("DEFVAR GF@__type_conver_var2\n");
+    ir_add1(gen->code, IR_DEFVAR, ir_gf("__type_conver_var1"));
+    ir_add1(gen->code, IR_DEFVAR, ir_gf("__type_conver_var2"));
 
-    printf("DEFVAR GF@__type_conver_type1\n");
-    printf("DEFVAR GF@__type_conver_type2\n");
+    ir_add1(gen->code, IR_DEFVAR, ir_gf("__type_conver_type1"));
+    ir_add1(gen->code, IR_DEFVAR, ir_gf("__type_conver_type2"));
 
-    printf("DEFVAR GF@__type_conver_res\n");
+    ir_add1(gen->code, IR_DEFVAR, ir_gf("__type_conver_res"));
 
     // variables for checking types of operands in division
-    printf("DEFVAR GF@__typecheck_var\n");
-    printf("DEFVAR GF@__typecheck_type\n");
+    ir_add1(gen->code, IR_DEFVAR, ir_gf("__typecheck_var"));
+    ir_add1(gen->code, IR_DEFVAR, ir_gf("__typecheck_type"));
 
     // variable for checking condition in if/while with |extension|
-    printf("DEFVAR GF@__extcheck_var\n");
-    printf("DEFVAR GF@__extcheck_type\n");
-
-    // variables for checking if variable was already defined
-    printf("DEFVAR GF@__decl_cnt\n");
-    printf("MOVE GF@__decl_cnt int@0\n");
-    printf("DEFVAR GF@__decl_bool\n");
+    ir_add1(gen->code, IR_DEFVAR, ir_gf("__extcheck_var"));
+    ir_add1(gen->code, IR_DEFVAR, ir_gf("__extcheck_type"));
 
     // global variable for discarding result of a function/expression
-    printf("DEFVAR GF@_\n");
+    ir_add1(gen->code, IR_DEFVAR, ir_gf("_"));
 
     // Main Frame
-    printf("CREATEFRAME\n");
-    printf("PUSHFRAME\n");
-    printf("CALL main\n");
-    printf("EXIT int@0\n");
+    ir_add0(gen->code, IR_CREATEFRAME);
+    ir_add0(gen->code, IR_PUSHFRAME);
+    ir_add1(gen->code, IR_CALL, ir_label_name("main"));
+    ir_add1(gen->code, IR_EXIT, ir_int_const(0));
 }
 
 /********************** MAIN PUBLIC FUNCTION ***************************/
-void generate_code(AST *ast){
-    ast->active = ast->root;
-
-    generate_initial_values();
-
-    // Without while, the generation ends after first function definition
-    while (ast->active->token->type != eof_token){
-        generate_code_for_line(ast->active, ast); // starts the generation
-
-        next_node(ast); // skip '}'
-    }
+void generate_code(compiler_t *compiler, emitter_t *out){
+    AST *ast = compiler->ast;
+    codegen_t state = {0};
+    codegen_t *gen = &state;
+    gen->arena = &compiler->arena;
+    gen->code = &compiler->code;
+    gen->out = out;
+    gen->diag = &compiler->diag;
+    ir_init(gen->code, gen->diag);
+
+    size_t names = compiler->intern.count * sizeof(uint32_t);
+    gen->name_function = arena_alloc(gen->arena, names);
+    gen->name_uses = arena_alloc(gen->arena, names);
+    memset(gen->name_function, 0, names);
+
+    emit_literal(gen->out, ".IFJcode24\n");
+    generate_initial_values(gen);
+    generate_flush(gen);
+
+    // Top level statements, function definitions are among them
+    generate_block(ast, ast->child[ast->root], gen);
 
     // Generate language built-in functions
-    generate_builtin_functions();
+    generate_builtin_functions(gen);
+    generate_flush(gen);
+}
+
+// Prints instructions generated so far and starts new list
+// Called after every function, so only one function is kept in memory
+void generate_flush(codegen_t *gen){
+    ir_print(gen->code, gen->out);
+    ir_clear(gen->code);
 }
 
-// Based on current node in AST chooses what's gonna be generated
-// Ends after whole function definition was generated
-void generate_code_for_line(ASTNode *token_node, AST *ast){
-    // Loop until we reach end of block or "EOF"
-    while(token_node->token->type != eof_token && (strcmp(token_node->token->data, "}") != 0) && (strcmp(token_node->token->data, "return") != 0)){
+// Generates code for every statement in the list
+// Return can only be the last statement of block
+void generate_block(AST *ast, ast_index_t node, codegen_t *gen){
+    for (; node != AST_NONE; node = ast->next[node]){
 
-        if (strcmp(token_node->token->data, "var") == 0 || strcmp(token_node->token->data, "const") == 0){
-            generate_variable_declaration(token_node, ast);
+        if (ast->type[node] == node_var_decl){
+            generate_variable_declaration(ast, node, gen);
+        }
+        else if (ast->type[node] == node_if){
+            generate_if_statement(ast, node, gen);
         }
-        else if (strcmp(token_node->token->data, "if") == 0){
-            generate_if_statement(token_node, ast);
+        else if (ast->type[node] == node_while){
+            generate_while_loop(ast, node, gen);
         }
-        else if (strcmp(token_node->token->data, "while") == 0){
-            generate_while_loop(token_node, ast);
+        else if (ast->type[node] == node_function){
+            generate_function_definition(ast, node, gen);
         }
-        else if (strcmp(token_node->token->data, "pub") == 0){
-            generate_function_definition(token_node, ast);
+        else if (ast->type[node] == node_return){
+            generate_function_return(ast, node, gen);
         }
         else{
-            generate_assignment_or_expression(token_node, ast);
+            generate_assignment_or_expression(ast, node, gen);
         }
-
-        token_node = ast->active; // updates token to be up to date
     }
 }
 
 // Generates code to perform expression
-void generate_expression(ASTNode *token_node, AST *ast){
-    char *current_token_data = token_node->token->data;
-    int current_token_type = token_node->token->type;
-
-    // Static variables to keep track of number of operations for unique labels
-    static int bi_operations_counter = 0;
-    static int div_counter = 0;
-
-    // Every expression ends ';' or ')'
-    while (strcmp(current_token_data, ";") != 0 && strcmp(current_token_data,")") != 0){
+void generate_expression(AST *ast, ast_index_t node, codegen_t *gen){
+    // Operators on operands of known types need no run time checks
+    infer_expression_types(ast, node, gen);
+    uint8_t *info = gen->expr_info;
+
+    // Goes through operands and operators in postfix order
+    for (uint32_t i = 0; i < ast->payload[node].postfix.count; i++){
+        token_t *token = ast_postfix(ast, node, i);
+        int current_token_type = token->type;
+        token_kind_t current_token_kind = token->kind;
+        bool dynamic = info[i] & expr_dynamic;
+
+        // Constant used by folded operation was already evaluated
+        if (info[i] & expr_folded){
+            continue;
+        }
+        // Literal or result of operation evaluated at compile time
+        if (info[i] & expr_const){
+            ir_add1(gen->code, IR_PUSHS, gen->expr_value[i]);
+            continue;
+        }
 
         // +    -   *   /   <   <=  >   >= 
         // Generates code to check if operands are same types, if not does the necessary conversions
-        if (current_token_type == binary_operator_token || current_token_type == relational_operator_token){
+        if (dynamic && (current_token_type == binary_operator_token || current_token_type == relational_operator_token)){
             // Pops last 2 operands from stack and checks their types
-            printf("POPS GF@__type_conver_var1\n");
-            printf("POPS GF@__type_conver_var2\n");
-            printf("TYPE GF@__type_conver_type1 GF@__type_conver_var1\n");
-            printf("TYPE GF@__type_conver_type2 GF@__type_conver_var2\n");
+            ir_add1(gen->code, IR_POPS, ir_gf("__type_conver_var1"));
+            ir_add1(gen->code, IR_POPS, ir_gf("__type_conver_var2"));
+            ir_add2(gen->code, IR_TYPE, ir_gf("__type_conver_type1"), ir_gf("__type_conver_var1"));
+            ir_add2(gen->code, IR_TYPE, ir_gf("__type_conver_type2"), ir_gf("__type_conver_var2"));
     
             // If one of the operands is of type nill -> exits
-            printf("JUMPIFEQ null_error_exit%d GF@__type_conver_type1 string@nil\n", bi_operations_counter);
-            printf("JUMPIFEQ null_error_exit%d GF@__type_conver_type2 string@nil\n", bi_operations_counter);
+            ir_add3(gen->code, IR_JUMPIFEQ, ir_label_n("null_error_exit", gen->bi_operations_counter), ir_gf("__type_conver_type1"), ir_string_const("nil"));
+            ir_add3(gen->code, IR_JUMPIFEQ, ir_label_n("null_error_exit", gen->bi_operations_counter), ir_gf("__type_conver_type2"), ir_string_const("nil"));
 
             // Compares the types
-            printf("EQ GF@__type_conver_res GF@__type_conver_type1 GF@__type_conver_type2\n");
+            ir_add3(gen->code, IR_EQ, ir_gf("__type_conver_res"), ir_gf("__type_conver_type1"), ir_gf("__type_conver_type2"));
             // If same types, no conversion needed
-            printf("JUMPIFEQ convert_push_back%d GF@__type_conver_res bool@true\n", bi_operations_counter);
+            ir_add3(gen->code, IR_JUMPIFEQ, ir_label_n("convert_push_back", gen->bi_operations_counter), ir_gf("__type_conver_res"), ir_bool_const(true));
             // If this is true, 1. operand is float, 2. is int
-            printf("JUMPIFEQ convert_second%d GF@__type_conver_type1 string@float\n", bi_operations_counter);
+            ir_add3(gen->code, IR_JUMPIFEQ, ir_label_n("convert_second", gen->bi_operations_counter), ir_gf("__type_conver_type1"), ir_string_const("float"));
             
             // Converts 1. operand
-            printf("PUSHS GF@__type_conver_var2\n");
-            printf("PUSHS GF@__type_conver_var1\n");
-            printf("INT2FLOATS\n");
+            ir_add1(gen->code, IR_PUSHS, ir_gf("__type_conver_var2"));
+            ir_add1(gen->code, IR_PUSHS, ir_gf("__type_conver_var1"));
+            ir_add0(gen->code, IR_INT2FLOATS);
 
-            printf("JUMP convert_end%d\n", bi_operations_counter);
+            ir_add1(gen->code, IR_JUMP, ir_label_n("convert_end", gen->bi_operations_counter));
 
             // Converts 2. operand
-            printf("LABEL convert_second%d\n", bi_operations_counter);
-            printf("PUSHS GF@__type_conver_var2\n");
-            printf("INT2FLOATS\n");
-            printf("PUSHS GF@__type_conver_var1\n");
+            ir_add1(gen->code, IR_LABEL, ir_label_n("convert_second", gen->bi_operations_counter));
+            ir_add1(gen->code, IR_PUSHS, ir_gf("__type_conver_var2"));
+            ir_add0(gen->code, IR_INT2FLOATS);
+            ir_add1(gen->code, IR_PUSHS, ir_gf("__type_conver_var1"));
 
-            printf("JUMP convert_end%d\n", bi_operations_counter);
+            ir_add1(gen->code, IR_JUMP, ir_label_n("convert_end", gen->bi_operations_counter));
 
             // If one of the operands was null -> exits with error
-            printf("LABEL null_error_exit%d\n", bi_operations_counter);
-            printf("EXIT int@7\n");
+            ir_add1(gen->code, IR_LABEL, ir_label_n("null_error_exit", gen->bi_operations_counter));
+            ir_add1(gen->code, IR_EXIT, ir_int_const(7));
 
             // If same types, just push the operands back onto the stack
-            printf("LABEL convert_push_back%d\n", bi_operations_counter);
-            printf("PUSHS GF@__type_conver_var2\n");
-            printf("PUSHS GF@__type_conver_var1\n");
+            ir_add1(gen->code, IR_LABEL, ir_label_n("convert_push_back", gen->bi_operations_counter));
+            ir_add1(gen->code, IR_PUSHS, ir_gf("__type_conver_var2"));
+            ir_add1(gen->code, IR_PUSHS, ir_gf("__type_conver_var1"));
 
-            printf("LABEL convert_end%d\n", bi_operations_counter);
+            ir_add1(gen->code, IR_LABEL, ir_label_n("convert_end", gen->bi_operations_counter));
 
-            bi_operations_counter++;
+            gen->bi_operations_counter++;
         }
         // Generates code to check if operands are same types, if not does the necessary conversions
         // Works similiar as other operators but have to check for null differently
             // because (nill == nill) == true
-        else if (current_token_type == double_equal_token || current_token_type == not_equal_token){
+        else if (dynamic && (current_token_type == double_equal_token || current_token_type == not_equal_token)){
             // Pops last 2 operands from stack and checks their types
-            printf("POPS GF@__type_conver_var1\n");
-            printf("POPS GF@__type_conver_var2\n");
-            printf("TYPE GF@__type_conver_type1 GF@__type_conver_var1\n");
-            printf("TYPE GF@__type_conver_type2 GF@__type_conver_var2\n");
+            ir_add1(gen->code, IR_POPS, ir_gf("__type_conver_var1"));
+            ir_add1(gen->code, IR_POPS, ir_gf("__type_conver_var2"));
+            ir_add2(gen->code, IR_TYPE, ir_gf("__type_conver_type1"), ir_gf("__type_conver_var1"));
+            ir_add2(gen->code, IR_TYPE, ir_gf("__type_conver_type2"), ir_gf("__type_conver_var2"));
     
             // If one of the operands is null, no conversion needed and we can just compare them
-            printf("JUMPIFEQ convert_push_back%d GF@__type_conver_type1 string@nil\n", bi_operations_counter);
-            printf("JUMPIFEQ convert_push_back%d GF@__type_conver_type2 string@nil\n", bi_operations_counter);
+            ir_add3(gen->code, IR_JUMPIFEQ, ir_label_n("convert_push_back", gen->bi_operations_counter), ir_gf("__type_conver_type1"), ir_string_const("nil"));
+            ir_add3(gen->code, IR_JUMPIFEQ, ir_label_n("convert_push_back", gen->bi_operations_counter), ir_gf("__type_conver_type2"), ir_string_const("nil"));
 
             // Compares the types
-            printf("EQ GF@__type_conver_res GF@__type_conver_type1 GF@__type_conver_type2\n");
+            ir_add3(gen->code, IR_EQ, ir_gf("__type_conver_res"), ir_gf("__type_conver_type1"), ir_gf("__type_conver_type2"));
             // If same types, no conversion needed
-            printf("JUMPIFEQ convert_push_back%d GF@__type_conver_res bool@true\n", bi_operations_counter);
+            ir_add3(gen->code, IR_JUMPIFEQ, ir_label_n("convert_push_back", gen->bi_operations_counter), ir_gf("__type_conver_res"), ir_bool_const(true));
             // If this is true, 1. operand is float, 2. is int
-            printf("JUMPIFEQ convert_second%d GF@__type_conver_type1 string@float\n", bi_operations_counter);
+            ir_add3(gen->code, IR_JUMPIFEQ, ir_label_n("convert_second", gen->bi_operations_counter), ir_gf("__type_conver_type1"), ir_string_const("float"));
             
             // Converts 1. operand
-            printf("PUSHS GF@__type_conver_var2\n");
-            printf("PUSHS GF@__type_conver_var1\n");
-            printf("INT2FLOATS\n");
+            ir_add1(gen->code, IR_PUSHS, ir_gf("__type_conver_var2"));
+            ir_add1(gen->code, IR_PUSHS, ir_gf("__type_conver_var1"));
+            ir_add0(gen->code, IR_INT2FLOATS);
 
-            printf("JUMP convert_end%d\n", bi_operations_counter);
+            ir_add1(gen->code, IR_JUMP, ir_label_n("convert_end", gen->bi_operations_counter));
 
             // Converts 2. operand
-            printf("LABEL convert_second%d\n", bi_operations_counter);
-            printf("PUSHS GF@__type_conver_var2\n");
-            printf("INT2FLOATS\n");
-            printf("PUSHS GF@__type_conver_var1\n");
+            ir_add1(gen->code, IR_LABEL, ir_label_n("convert_second", gen->bi_operations_counter));
+            ir_add1(gen->code, IR_PUSHS, ir_gf("__type_conver_var2"));
+            ir_add0(gen->code, IR_INT2FLOATS);
+            ir_add1(gen->code, IR_PUSHS, ir_gf("__type_conver_var1"));
 
-            printf("JUMP convert_end%d\n", bi_operations_counter);
+            ir_add1(gen->code, IR_JUMP, ir_label_n("convert_end", gen->bi_operations_counter));
 
             // If same types of operands, just pushes them back onto the stack
-            printf("LABEL convert_push_back%d\n", bi_operations_counter);
-            printf("PUSHS GF@__type_conver_var2\n");
-            printf("PUSHS GF@__type_conver_var1\n");
+            ir_add1(gen->code, IR_LABEL, ir_label_n("convert_push_back", gen->bi_operations_counter));
+            ir_add1(gen->code, IR_PUSHS, ir_gf("__type_conver_var2"));
+            ir_add1(gen->code, IR_PUSHS, ir_gf("__type_conver_var1"));
 
-            printf("LABEL convert_end%d\n", bi_operations_counter);
+            ir_add1(gen->code, IR_LABEL, ir_label_n("convert_end", gen->bi_operations_counter));
 
-            bi_operations_counter++;
+            gen->bi_operations_counter++;
+        }
+        // Types are known, only int operand of float operation is converted
+        else if (info[i] & expr_widen_left){
+            ir_add1(gen->code, IR_POPS, ir_gf("__type_conver_var1"));
+            ir_add0(gen->code, IR_INT2FLOATS);
+            ir_add1(gen->code, IR_PUSHS, ir_gf("__type_conver_var1"));
+        }
+        else if (info[i] & expr_widen_right){
+            ir_add0(gen->code, IR_INT2FLOATS);
         }
 
         // Generates code to perform the corresponding operation
-        if(strcmp(current_token_data, "<") == 0){
-            printf("LTS\n");
+        if(current_token_kind == kind_less){
+            ir_add0(gen->code, IR_LTS);
         }
-        else if(strcmp(current_token_data, ">") == 0){
-            printf("GTS\n");
+        else if(current_token_kind == kind_greater){
+            ir_add0(gen->code, IR_GTS);
         }
-        else if(strcmp(current_token_data, "<=") == 0){
-            printf("GTS\n");
-            printf("NOTS\n");
+        else if(current_token_kind == kind_less_equal){
+            ir_add0(gen->code, IR_GTS);
+            ir_add0(gen->code, IR_NOTS);
         }
-        else if(strcmp(current_token_data, ">=") == 0){
-            printf("LTS\n");
-            printf("NOTS\n");
+        else if(current_token_kind == kind_greater_equal){
+            ir_add0(gen->code, IR_LTS);
+            ir_add0(gen->code, IR_NOTS);
         }
-        else if(strcmp(current_token_data, "!=") == 0){
-            printf("EQS\n");
-            printf("NOTS\n");
+        else if(current_token_kind == kind_not_equal){
+            ir_add0(gen->code, IR_EQS);
+            ir_add0(gen->code, IR_NOTS);
         }
-        else if(strcmp(current_token_data, "==") == 0){
-            printf("EQS\n");
+        else if(current_token_kind == kind_equal){
+            ir_add0(gen->code, IR_EQS);
         }
-        else if(strcmp(current_token_data, "+") == 0){
-            printf("ADDS\n");
+        else if(current_token_kind == kind_plus){
+            ir_add0(gen->code, IR_ADDS);
         }
-        else if(strcmp(current_token_data, "-") == 0){
-            printf("SUBS\n");
+        else if(current_token_kind == kind_minus){
+            ir_add0(gen->code, IR_SUBS);
         }
-        else if(strcmp(current_token_data, "*") == 0){
-            printf("MULS\n");
+        else if(current_token_kind == kind_multiply){
+            ir_add0(gen->code, IR_MULS);
         }
-        else if(strcmp(current_token_data, "/") == 0){
+        // Float division of known types
+        else if(current_token_kind == kind_divide && !dynamic && (info[i] & expr_type_mask) == value_float){
+            ir_add0(gen->code, IR_DIVS);
+        }
+        // Integer division of known types, only zero divisor is checked
+        else if(current_token_kind == kind_divide && !dynamic){
+            if (!(info[i] & expr_nonzero)){
+                ir_add1(gen->code, IR_POPS, ir_gf("__typecheck_var"));
+                ir_add3(gen->code, IR_JUMPIFNEQ, ir_label_n("division_continuation", gen->div_counter), ir_gf("__typecheck_var"), ir_int_const(0));
+                ir_add1(gen->code, IR_EXIT, ir_int_const(57));
+                ir_add1(gen->code, IR_LABEL, ir_label_n("division_continuation", gen->div_counter));
+                ir_add1(gen->code, IR_PUSHS, ir_gf("__typecheck_var"));
+                gen->div_counter++;
+            }
+            ir_add0(gen->code, IR_IDIVS);
+        }
+        else if(current_token_kind == kind_divide){
             // Checks the type of operand on top of stack
             // We know both operands have to be already same type
-            printf("POPS GF@__typecheck_var\n");
-            printf("TYPE GF@__typecheck_type GF@__typecheck_var\n");
+            ir_add1(gen->code, IR_POPS, ir_gf("__typecheck_var"));
+            ir_add2(gen->code, IR_TYPE, ir_gf("__typecheck_type"), ir_gf("__typecheck_var"));
 
             // Checks if the last operand on the stack is int == if we can compare it to 0
-            printf("JUMPIFNEQ division_continuation%d GF@__typecheck_type string@int\n", div_counter);
+            ir_add3(gen->code, IR_JUMPIFNEQ, ir_label_n("division_continuation", gen->div_counter), ir_gf("__typecheck_type"), ir_string_const("int"));
 
             // Checks for division by 0
-            printf("JUMPIFNEQ division_continuation%d GF@__typecheck_var int@0\n", div_counter);
-            printf("EXIT int@57\n");
+            ir_add3(gen->code, IR_JUMPIFNEQ, ir_label_n("division_continuation", gen->div_counter), ir_gf("__typecheck_var"), ir_int_const(0));
+            ir_add1(gen->code, IR_EXIT, ir_int_const(57));
 
             // Continues here if not dividing by 0
-            printf("LABEL division_continuation%d\n", div_counter);
-            printf("PUSHS GF@__typecheck_var\n");
+            ir_add1(gen->code, IR_LABEL, ir_label_n("division_continuation", gen->div_counter));
+            ir_add1(gen->code, IR_PUSHS, ir_gf("__typecheck_var"));
             // Generates code to check if it's integer or float division
-            printf("JUMPIFEQ __div_int%d GF@__typecheck_type string@int\n", div_counter);
-            printf("DIVS\n");
-            printf("JUMP __div_end%d\n", div_counter);
-            printf("LABEL __div_int%d\n", div_counter);
-            printf("IDIVS\n");
-            printf("LABEL __div_end%d\n", div_counter);
-            div_counter++;
+            ir_add3(gen->code, IR_JUMPIFEQ, ir_label_n("__div_int", gen->div_counter), ir_gf("__typecheck_type"), ir_string_const("int"));
+            ir_add0(gen->code, IR_DIVS);
+            ir_add1(gen->code, IR_JUMP, ir_label_n("__div_end", gen->div_counter));
+            ir_add1(gen->code, IR_LABEL, ir_label_n("__div_int", gen->div_counter));
+            ir_add0(gen->code, IR_IDIVS);
+            ir_add1(gen->code, IR_LABEL, ir_label_n("__div_end", gen->div_counter));
+            gen->div_counter++;
         }
         // variables - pushes them onto the stack
         else if(current_token_type == identifier_token){
-            printf("PUSHS LF@%s\n", token_node->token->data);
+            ir_add1(gen->code, IR_PUSHS, ir_lf(ast_postfix_symbol(ast, node, i)->name));
         }
-        // literals - pushes them onto the stack
+        // null literal, int and float literals are constants pushed above
         else{
-            if(current_token_type == int_token){
-                printf("PUSHS int@%s\n", current_token_data);
-            }
-            else if(current_token_type == float_token){
-                // Converts string to actual double value
-                char *tmp;
-                double value = strtod(current_token_data, &tmp);
-                printf("PUSHS float@%a\n", value);
-            }
-            else if(current_token_type == null_token){
-                printf("PUSHS nil@nil\n");
+            if(current_token_type == null_token){
+                ir_add1(gen->code, IR_PUSHS, ir_nil_const());
             }
             // Anything else shouldn't be possible if semantic analyser is working correctly
             else{
-                exit(7);
+                diag_raise(gen->diag, 7, "Semantic error 7: Unexpected operand in expression");
             }
         }
-        token_node = next_node(ast); // next token
-        current_token_data = token_node->token->data;
-        current_token_type = token_node->token->type;
     }
 }
 
-// Generates IF STATEMENT
-void generate_if_statement(ASTNode *token_node, AST *ast){
-    token_node = next_node(ast);    // Skip 'if'
-    token_node = next_node(ast);    // skip '(' and go to expression "xxx..."
+// Finds types of values in expression known at compile time and conversions they need
+// Operations on constants are evaluated, result is in gen->expr_info, one item for every token
+void infer_expression_types(AST *ast, ast_index_t node, codegen_t *gen){
+    uint32_t count = ast->payload[node].postfix.count;
+    // Old arrays stay in arena, they are replaced only by larger ones
+    if (count > gen->expr_capacity){
+        gen->expr_capacity = count < 2 * gen->expr_capacity ? 2 * gen->expr_capacity : count;
+        gen->expr_value = arena_alloc(gen->arena, gen->expr_capacity * sizeof(ir_operand_t));
+        gen->expr_stack = arena_alloc(gen->arena, gen->expr_capacity * sizeof(uint32_t));
+        gen->expr_info = arena_alloc(gen->arena, gen->expr_capacity);
+    }
 
-    static int if_label_counter = 0;    // for generating unique labels
-    int current_if_label = if_label_counter++;  // Saves the current value, because there might be nested IFs
+    // Stack holds position of token which produced the value
+    uint32_t top = 0;
+    for (uint32_t i = 0; i < count; i++){
+        token_t *token = ast_postfix(ast, node, i);
 
-    // Checks what type of condition it is and generates conditional jumps
-    // if (cond) |y| {}
-    if (strcmp(token_node->next->next->token->data, "|") == 0){
-        
-        printf("MOVE GF@__extcheck_var LF@%s\n", token_node->token->data);
-        printf("TYPE GF@__extcheck_type GF@__extcheck_var\n");
+        if (token->type == int_token){
+            gen->expr_info[i] = expr_const | value_int;
+            gen->expr_value[i] = ir_int_const(token->int_value);
+        }
+        else if (token->type == float_token){
+            gen->expr_info[i] = expr_const | value_float;
+            gen->expr_value[i] = ir_float_const(token->float_value);
+        }
+        else if (token->type == identifier_token){
+            gen->expr_info[i] = ast_postfix_symbol(ast, node, i)->type == sym_int_type ? value_int : value_unknown;
+        }
+        else if (token->type == binary_operator_token || token->type == relational_operator_token ||
+                token->type == double_equal_token || token->type == not_equal_token){
+            uint32_t right = gen->expr_stack[--top];
+            uint32_t left = gen->expr_stack[--top];
+            gen->expr_info[i] = infer_operation(token, left, right, i, gen);
+        }
+        else {
+            gen->expr_info[i] = value_unknown;
+        }
+        gen->expr_stack[top++] = i;
+    }
+}
 
-        printf("JUMPIFEQ if_else%d GF@__extcheck_type string@nil\n", current_if_label);
+// Returns info of operator at position with operands produced by tokens at positions left and right
+// Operation on two constants is folded, int constant of float operation is widened right away
+uint8_t infer_operation(token_t *token, uint32_t left, uint32_t right, uint32_t position, codegen_t *gen){
+    uint8_t *info = gen->expr_info;
+    value_type_t left_type = info[left] & expr_type_mask;
+    value_type_t right_type = info[right] & expr_type_mask;
+    bool arithmetic = token->type == binary_operator_token;
 
-        token_node = next_node(ast);    // skip 'cond'
-        token_node = next_node(ast);    // skip ')'
-        token_node = next_node(ast);    // skip '|'
+    if ((left_type != value_int && left_type != value_float) || (right_type != value_int && right_type != value_float)){
+        return expr_dynamic | value_unknown;
+    }
 
-        // Generates checks for variable redeclaration
-        printf("GT GF@__decl_bool GF@__decl_cnt int@%d\n", global_decl_cnt);
-        printf("JUMPIFEQ ex_declskip%d GF@__decl_bool bool@true \n", current_if_label);
+    // Both operands are known, operation is replaced by its result
+    if ((info[left] & expr_const) && (info[right] & expr_const) &&
+        fold_operation(token->kind, gen->expr_value[left], gen->expr_value[right], &gen->expr_value[position])){
+        info[left] |= expr_folded;
+        info[right] |= expr_folded;
+        ir_operand_kind_t kind = gen->expr_value[position].kind;
+        return expr_const | (kind == ir_int ? value_int : kind == ir_float ? value_float : value_bool);
+    }
 
-            printf("DEFVAR LF@%s\n", token_node->token->data);
+    uint8_t result;
+    if (left_type == value_int && right_type == value_int){
+        result = arithmetic ? value_int : value_bool;
+        // Division by zero is checked only for divisor that is not constant
+        if (token->kind == kind_divide && (info[right] & expr_const) && gen->expr_value[right].value.int_value != 0){
+            result |= expr_nonzero;
+        }
+        return result;
+    }
 
-            global_decl_cnt++;
-            printf("MOVE GF@__decl_cnt int@%d\n", global_decl_cnt);
-            
-        printf("LABEL ex_declskip%d\n", current_if_label);
-            
-        printf("MOVE LF@%s GF@__extcheck_var\n", token_node->token->data);
+    result = arithmetic ? value_float : value_bool;
+    if (left_type == value_int){
+        if (info[left] & expr_const){
+            widen_constant(&gen->expr_value[left]);
+        }
+        else {
+            result |= expr_widen_left;
+        }
+    }
+    else if (right_type == value_int){
+        if (info[right] & expr_const){
+            widen_constant(&gen->expr_value[right]);
+        }
+        else {
+            result |= expr_widen_right;
+        }
+    }
+    return result;
+}
 
-        token_node = next_node(ast);    // skip 'y'
-        token_node = next_node(ast);    // skip '|'
+// Converts int constant to float
+void widen_constant(ir_operand_t *value){
+    if (value->kind == ir_int){
+        *value = ir_float_const((double)value->value.int_value);
     }
-    // if (expr) {}
-    else{
-        generate_expression(token_node, ast);
+}
 
-        token_node = ast->active;   // Have to update token_node pointer after generate_expression
-        token_node = next_node(ast);    // skip ')'
+// Evaluates operation on int or float constants the way interpreter does, int is widened if other is float
+// Returns false when operation has to stay for run time: division by zero, inexact negative int quotient, int overflow,
+// result that is not finite
+bool fold_operation(token_kind_t kind, ir_operand_t left, ir_operand_t right, ir_operand_t *result){
+    if (left.kind != right.kind){
+        widen_constant(&left);
+        widen_constant(&right);
+    }
 
-        printf("POPS GF@__condition_bool\n"); // pop the condition result into global variable
-    
-        printf("JUMPIFEQ if_then%d GF@__condition_bool bool@true\n", current_if_label);
-        printf("JUMP if_else%d\n", current_if_label);
+    if (left.kind == ir_int){
+        int64_t a = left.value.int_value;
+        int64_t b = right.value.int_value;
+        int64_t r;
+        switch (kind){
+            case kind_plus:
+                if (__builtin_add_overflow(a, b, &r)) return false;
+                break;
+            case kind_minus:
+                if (__builtin_sub_overflow(a, b, &r)) return false;
+                break;
+            case kind_multiply:
+                if (__builtin_mul_overflow(a, b, &r)) return false;
+                break;
+            case kind_divide:
+                // Division by zero stays as run time error 57
+                if (b == 0 || (a == INT64_MIN && b == -1)) return false;
+                // Inexact quotient of operands with different signs depends on rounding of IDIVS
+                if ((a < 0) != (b < 0) && a % b != 0) return false;
+                r = a / b;
+                break;
+            case kind_less:             *result = ir_bool_const(a < b); return true;
+            case kind_greater:          *result = ir_bool_const(a > b); return true;
+            case kind_less_equal:       *result = ir_bool_const(a <= b); return true;
+            case kind_greater_equal:    *result = ir_bool_const(a >= b); return true;
+            case kind_equal:            *result = ir_bool_const(a == b); return true;
+            case kind_not_equal:        *result = ir_bool_const(a != b); return true;
+            default:
+                return false;
+        }
+        *result = ir_int_const(r);
+        return true;
     }
 
-    // Generate THEN branch
-    printf("LABEL if_then%d\n", current_if_label);
+    double a = left.value.float_value;
+    double b = right.value.float_value;
+    double r;
+    switch (kind){
+        case kind_plus:     r = a + b; break;
+        case kind_minus:    r = a - b; break;
+        case kind_multiply: r = a * b; break;
+        case kind_divide:
+            if (b == 0.0) return false;
+            r = a / b;
+            break;
+        case kind_less:             *result = ir_bool_const(a < b); return true;
+        case kind_greater:          *result = ir_bool_const(a > b); return true;
+        case kind_less_equal:       *result = ir_bool_const(a <= b); return true;
+        case kind_greater_equal:    *result = ir_bool_const(a >= b); return true;
+        case kind_equal:            *result = ir_bool_const(a == b); return true;
+        case kind_not_equal:        *result = ir_bool_const(a != b); return true;
+        default:
+            return false;
+    }
+    if (!isfinite(r)){
+        return false;
+    }
+    *result = ir_float_const(r);
+    return true;
+}
 
-    token_node = next_node(ast); // Skip '{'
+// Generates IF STATEMENT
+void generate_if_statement(AST *ast, ast_index_t node, codegen_t *gen){
+    int current_if_label = gen->if_label_counter++;  // Saves the current value, because there might be nested IFs
 
-    generate_code_for_line(token_node, ast);
-    token_node = ast->active;
+    // Checks what type of condition it is and generates conditional jumps
+    // if (cond) |y| {}
+    if (ast->payload[node].token != NULL){
+        
+        ir_add2(gen->code, IR_MOVE, ir_gf("__extcheck_var"), ir_lf(ast_postfix_symbol(ast, ast->child[node], 0)->name));
+        ir_add2(gen->code, IR_TYPE, ir_gf("__extcheck_type"), ir_gf("__extcheck_var"));
 
-    // Have to check if jumped out because of return or end of block
-    if (strcmp(token_node->token->data, "return") == 0){
-        generate_function_return(token_node, ast);
-        token_node = ast->active;
+        ir_add3(gen->code, IR_JUMPIFEQ, ir_label_n("if_else", current_if_label), ir_gf("__extcheck_type"), ir_string_const("nil"));
 
-        // If there was some dead code after the return, that we dont have to print...
-        while (strcmp(token_node->token->data, "}") != 0){
-            token_node = next_node(ast);
-        }
+        // Variable is defined at the beginning of function
+        ir_add2(gen->code, IR_MOVE, ir_lf(ast->symbol[node]->name), ir_gf("__extcheck_var"));
     }
+    // if (expr) {}
+    else{
+        generate_expression(ast, ast->child[node], gen);
 
-    printf("JUMP if_end%d\n", current_if_label);
-
-    token_node = ast->active;
-    token_node = next_node(ast);    // skip '}'
-    token_node = next_node(ast);    // skip 'else'
-    token_node = next_node(ast);    // '{'
+        ir_add1(gen->code, IR_POPS, ir_gf("__condition_bool")); // pop the condition result into global variable
+    
+        ir_add3(gen->code, IR_JUMPIFEQ, ir_label_n("if_then", current_if_label), ir_gf("__condition_bool"), ir_bool_const(true));
+        ir_add1(gen->code, IR_JUMP, ir_label_n("if_else", current_if_label));
+    }
 
-    // Generate ELSE branch
-    printf("LABEL if_else%d\n", current_if_label);
+    // Generate THEN branch
+    ir_add1(gen->code, IR_LABEL, ir_label_n("if_then", current_if_label));
 
-    generate_code_for_line(token_node, ast);
-    token_node = ast->active;
+    generate_block(ast, ast->child[ast_child(ast, node, 1)], gen);
 
-    // Have to check if jumped out because of return or end of block
-    if (strcmp(token_node->token->data, "return") == 0){
-        generate_function_return(token_node, ast);
-        token_node = ast->active;
+    ir_add1(gen->code, IR_JUMP, ir_label_n("if_end", current_if_label));
 
-        // If there was some dead code after the return, that we dont have to print...
-        while (strcmp(token_node->token->data, "}") != 0){
-            token_node = next_node(ast);
-        }
-    }
+    // Generate ELSE branch
+    ir_add1(gen->code, IR_LABEL, ir_label_n("if_else", current_if_label));
 
-    token_node = next_node(ast);    // skip '}'
+    generate_block(ast, ast->child[ast_child(ast, node, 2)], gen);
 
     // Skip here after completing then branch
-    printf("LABEL if_end%d\n", current_if_label);
+    ir_add1(gen->code, IR_LABEL, ir_label_n("if_end", current_if_label));
 }
 
 // Generates WHILE LOOP
-void generate_while_loop(ASTNode *token_node, AST *ast){
-    token_node = next_node(ast);    // Skip 'while'
-    token_node = next_node(ast);    // Skip '(' and move to condition
-
-    static int while_label_counter = 0; // static cnt to generate unique labels
-    int current_while_label = while_label_counter++;
+void generate_while_loop(AST *ast, ast_index_t node, codegen_t *gen){
+    int current_while_label = gen->while_label_counter++;
 
     // Checks what type of while loop it is and generates conditional jumps
     // while (cond) |y| {}
-    if (strcmp(token_node->next->next->token->data, "|") == 0){
-        // Initial check if the value in condition != null
-        printf("MOVE GF@__extcheck_var LF@%s\n", token_node->token->data);
-        printf("TYPE GF@__extcheck_type GF@__extcheck_var\n");
-        printf("JUMPIFEQ while_end%d GF@__extcheck_type string@nil\n", current_while_label);
+    if (ast->payload[node].token != NULL){
+        char *condition = ast_postfix_symbol(ast, ast->child[node], 0)->name;
 
-        // If so, define new variable and move value of the condition into it
-        // Generates checks for variable redeclaration
-        printf("GT GF@__decl_bool GF@__decl_cnt int@%d\n", global_decl_cnt);
-        printf("JUMPIFEQ ex_declskip%d GF@__decl_bool bool@true \n", current_while_label);
-
-            printf("DEFVAR LF@%s\n", token_node->next->next->next->token->data);
-            global_decl_cnt++;
-            printf("MOVE GF@__decl_cnt int@%d\n", global_decl_cnt);
+        // Initial check if the value in condition != null
+        ir_add2(gen->code, IR_MOVE, ir_gf("__extcheck_var"), ir_lf(condition));
+        ir_add2(gen->code, IR_TYPE, ir_gf("__extcheck_type"), ir_gf("__extcheck_var"));
+        ir_add3(gen->code, IR_JUMPIFEQ, ir_label_n("while_end", current_while_label), ir_gf("__extcheck_type"), ir_string_const("nil"));
 
-        printf("LABEL ex_declskip%d\n", current_while_label);
-        
-        printf("MOVE LF@%s GF@__extcheck_var\n", token_node->next->next->next->token->data);
+        // If so, move value of the condition into variable defined at the beginning of function
+        ir_add2(gen->code, IR_MOVE, ir_lf(ast->symbol[node]->name), ir_gf("__extcheck_var"));
 
         // While always returns here when reaching end of its block 
         // to recheck the condition and update value of the special variable
-        printf("LABEL while_start%d\n", current_while_label);
+        ir_add1(gen->code, IR_LABEL, ir_label_n("while_start", current_while_label));
 
-        printf("MOVE GF@__extcheck_var LF@%s\n", token_node->token->data);
-        printf("TYPE GF@__extcheck_type GF@__extcheck_var\n");
-        printf("JUMPIFEQ while_end%d GF@__extcheck_type string@nil\n", current_while_label);
+        ir_add2(gen->code, IR_MOVE, ir_gf("__extcheck_var"), ir_lf(condition));
+        ir_add2(gen->code, IR_TYPE, ir_gf("__extcheck_type"), ir_gf("__extcheck_var"));
+        ir_add3(gen->code, IR_JUMPIFEQ, ir_label_n("while_end", current_while_label), ir_gf("__extcheck_type"), ir_string_const("nil"));
         
         // update value of special var
-        printf("MOVE LF@%s GF@__extcheck_var\n", token_node->next->next->next->token->data);
-
-        token_node = next_node(ast);    // skip 'cond'
-        token_node = next_node(ast);    // skip ')'
-        token_node = next_node(ast);    // skip '|'
-        token_node = next_node(ast);    // skip 'y'
-        token_node = next_node(ast);    // skip '|'
+        ir_add2(gen->code, IR_MOVE, ir_lf(ast->symbol[node]->name), ir_gf("__extcheck_var"));
     }
     // while (cond) {}
     else{
-        printf("LABEL while_start%d\n", current_while_label);
-        generate_expression(token_node, ast);
+        ir_add1(gen->code, IR_LABEL, ir_label_n("while_start", current_while_label));
+        generate_expression(ast, ast->child[node], gen);
 
-        token_node = ast->active;   // Have to update token_node pointer after generate_expression
-        token_node = next_node(ast); // skip ')'
-        
         // Pop the condition result to global variable
-        printf("POPS GF@__condition_bool\n");
+        ir_add1(gen->code, IR_POPS, ir_gf("__condition_bool"));
 
         // If condition is false jump out of loop body
-        printf("JUMPIFEQ while_end%d GF@__condition_bool bool@false\n", current_while_label);
+        ir_add3(gen->code, IR_JUMPIFEQ, ir_label_n("while_end", current_while_label), ir_gf("__condition_bool"), ir_bool_const(false));
     }
 
-    token_node = next_node(ast);    // skip '{' and start generating loop body
-    generate_code_for_line(token_node, ast);
+    // loop body
+    generate_block(ast, ast->child[ast_child(ast, node, 1)], gen);
 
-    token_node = ast->active;
-    token_node = next_node(ast);    // skip '}'
-
-    printf("JUMP while_start%d\n", current_while_label);
-    printf("LABEL while_end%d\n", current_while_label);
+    ir_add1(gen->code, IR_JUMP, ir_label_n("while_start", current_while_label));
+    ir_add1(gen->code, IR_LABEL, ir_label_n("while_end", current_while_label));
 }
 
 // Generates code to declare new variable and assign it a value
@@ -487,68 +661,23 @@ void generate_while_loop(ASTNode *token_node, AST *ast){
     var z = x + 5;
     var a : []u8 = "radfsda"; 
 */
-void generate_variable_declaration(ASTNode *token_node, AST *ast){
-    token_node = next_node(ast);    // <- 'var_name', skip 'var'/'const'
-
-    static int decl_label_cnt = 0; // static cnt to generate unique labels
-
-    char *var_name = token_node->token->data;
-
-    /* If __decl_cnt > global_decl_cnt, skip declaration
-        This is only true, when going back in while loop, 
-        because the __decl_cnt already increased when going through the code for the first time
-        but the value of global_decl_cnt is printed
-    */
-    printf("GT GF@__decl_bool GF@__decl_cnt int@%d\n", global_decl_cnt);
-
-    printf("JUMPIFEQ declskip%d GF@__decl_bool bool@true \n", decl_label_cnt);
-
-        // If we are declaring variable for the first time, update the counters so interpret skips this part of code
-        //  next time when going back in while loop
-        printf("DEFVAR LF@%s\n", var_name);
-        global_decl_cnt++;
-        printf("MOVE GF@__decl_cnt int@%d\n", global_decl_cnt);
+void generate_variable_declaration(AST *ast, ast_index_t node, codegen_t *gen){
 
-    printf("LABEL declskip%d\n", decl_label_cnt);
+    // Variable is already defined at the beginning of function, so loops do not define it again
+    char *var_name = ast->symbol[node]->name;
 
-    decl_label_cnt++;
-
-    token_node = next_node(ast);    // ":" | "="
-
-    // Skips ": type" if included in declaration
-    if (strcmp(token_node->token->data, ":") == 0){
-        token_node = next_node(ast);    // skip ':'
-        token_node = next_node(ast);    // skip "type"
-    }
-
-    token_node = next_node(ast);    // skip '='
-    
     // Variable initialization
-    // var var_name = ID [variable or function call]
-    if (token_node->token->type == identifier_token){   
-        if (token_node->next->token->type == bracket_token){    // var var_name = <function_call>(
-            generate_function_call_assignment(var_name, token_node, ast);
-        }
-        else{   // var var_name = <expression>;
-            generate_expression_assignment(var_name, token_node, ast);
-            token_node = ast->active;
-            token_node = next_node(ast);    // skip ';'
-        }
+    // var var_name = <function_call>(
+    if (ast->type[ast->child[node]] == node_call){
+        generate_function_call_assignment(ast, var_name, ast->child[node], gen);
+    }
+    // var var_name = "string";
+    else if (ast_postfix(ast, ast->child[node], 0)->type == string_token){
+        generate_string_assignment(var_name, ast_postfix(ast, ast->child[node], 0), gen);
     }
     // var var_name = <expression>;
-    else{
-        if(token_node->token->type == string_token){
-            char *escaped_expr_temp = escape_string(token_node->token->data);
-            generate_string_assignment(var_name, escaped_expr_temp);
-            free(escaped_expr_temp);
-            token_node = next_node(ast);    // skip 'string'
-            token_node = next_node(ast);    // skip ';'
-        }
-        else {
-            generate_expression_assignment(var_name, token_node, ast);
-            token_node = ast->active;
-            token_node = next_node(ast);    // skip ';'
-        }
+    else {
+        generate_expression_assignment(ast, var_name, ast->child[node], gen);
     }
 }
 
@@ -556,597 +685,537 @@ void generate_variable_declaration(ASTNode *token_node, AST *ast){
 // x = a + b * c;
 // x = someFunction(a, b);
 // someFunction(a, b);
-void generate_assignment_or_expression(ASTNode *token_node, AST *ast){
-    char *identifier = token_node->token->data; // variable or function call name
-
-    token_node = next_node(ast); // skip 'ID'
+void generate_assignment_or_expression(AST *ast, ast_index_t node, codegen_t *gen){
+    // Variable or function name, call of built-in function has no symbol, its name is taken from token
+    char *identifier = ast->type[node] == node_call ? ast->payload[node].token->data : ast->symbol[node]->name;
 
     // Variable assignment
-    if(strcmp(token_node->token->data, "=") == 0){
-        token_node = next_node(ast); // skip '=' to R value
-
-        if(token_node->token->type == identifier_token){    // function call or expression
-            // check whats after identifier
-            if(strcmp(token_node->next->token->data, "(") == 0){ // Its a function call
-                generate_function_call_assignment(identifier, token_node, ast);
-            }
-            else{ // Its expression
-                generate_expression_assignment(identifier, token_node, ast);
-                token_node = ast->active;
-                token_node = next_node(ast);    // skip ';'
-            }
+    if(ast->type[node] == node_assignment){
+        if(ast->type[ast->child[node]] == node_call){ // Its a function call
+            generate_function_call_assignment(ast, identifier, ast->child[node], gen);
         }
-        else if(token_node->token->type == string_token){   // R value is a string
-            char *escaped_expr_temp = escape_string(token_node->token->data);
-            generate_string_assignment(identifier, escaped_expr_temp);
-            free(escaped_expr_temp);
-            token_node = next_node(ast);    // skip 'string'
-            token_node = next_node(ast);    // skip ';'
+        else if(ast_postfix(ast, ast->child[node], 0)->type == string_token){   // R value is a string
+            generate_string_assignment(identifier, ast_postfix(ast, ast->child[node], 0), gen);
         }
         else{   // R value is an expression
-            generate_expression_assignment(identifier, token_node, ast);
-            token_node = ast->active;
-            token_node = next_node(ast);    // skip ';'
+            generate_expression_assignment(ast, identifier, ast->child[node], gen);
         }
     }
     // Its a function call as a statement
-    else if(strcmp(token_node->token->data, "(") == 0){
-        generate_function_call(identifier, token_node, ast);
-        // Revert __decl_cnt to value before function call
-        printf("POPS GF@__decl_cnt\n");
+    else if(ast->type[node] == node_call){
+        generate_function_call(ast, identifier, node, gen);
     }
 }
 
 // Generates code to assign value from expression to a variable
-void generate_expression_assignment(char *identifier, ASTNode *token_node, AST *ast){
+void generate_expression_assignment(AST *ast, char *identifier, ast_index_t node, codegen_t *gen){
     // Generate expression code
-    generate_expression(token_node, ast);
+    generate_expression(ast, node, gen);
 
     // Pop the result into variable
     if (strcmp(identifier, "_") == 0){
-       printf("POPS GF@_\n"); 
+       ir_add1(gen->code, IR_POPS, ir_gf("_")); 
     }
     else {
-        printf("POPS LF@%s\n", identifier);
+        ir_add1(gen->code, IR_POPS, ir_lf(identifier));
     }
 }
 
 // Generates code to assign value from function call to a variable
-void generate_function_call_assignment(char *identifier, ASTNode *function_call_node, AST *ast){
+void generate_function_call_assignment(AST *ast, char *identifier, ast_index_t call_node, codegen_t *gen){
     // Generate function call code
-    char* function_name = function_call_node->token->data;
-    function_call_node = next_node(ast);
-    generate_function_call(function_name, function_call_node->next, ast);
+    generate_function_call(ast, ast->payload[call_node].token->data, call_node, gen);
 
     // Pop the value function returned into the variable
     if (strcmp(identifier, "_") == 0){
-        printf("POPS GF@_\n"); 
+        ir_add1(gen->code, IR_POPS, ir_gf("_")); 
     }
     else {
-        printf("POPS LF@%s\n", identifier);
+        ir_add1(gen->code, IR_POPS, ir_lf(identifier));
     }
-    // Revert __decl_cnt to value before function call
-    printf("POPS GF@__decl_cnt\n");
 }
 
-// Generates code to assign string to the 'identifier' variable
-void generate_string_assignment(char *identifier, char *string){
-    printf("PUSHS string@%s\n", string);
-    printf("POPS LF@%s\n", identifier);
+// Generates code to assign string literal to the 'identifier' variable
+void generate_string_assignment(char *identifier, token_t *string, codegen_t *gen){
+    ir_add1(gen->code, IR_PUSHS, ir_string_text(string->text, string->text_length));
+    ir_add1(gen->code, IR_POPS, ir_lf(identifier));
 }
 
 // Generates function call with the function call arguments
-void generate_function_call(char *function_name, ASTNode *token_node, AST *ast){
-    token_node = next_node(ast); // Skip '('
-
-    printf("CREATEFRAME\n");    // creates new frame for the function arguments
+void generate_function_call(AST *ast, char *function_name, ast_index_t call_node, codegen_t *gen){
+    ir_add0(gen->code, IR_CREATEFRAME);    // creates new frame for the function arguments
 
     int arg_count = 0;
-    // Generates code to save the arguments
-    while (strcmp(token_node->token->data, ")") != 0){
+    // Generates code to save the arguments, every argument is a single term
+    for (ast_index_t arg = ast->child[call_node]; arg != AST_NONE; arg = ast->next[arg]){
+        token_t *token = ast_postfix(ast, arg, 0);
 
-        printf("DEFVAR TF@__arg%d\n", arg_count);
+        ir_add1(gen->code, IR_DEFVAR, ir_var_n(IR_TF, "__arg", arg_count));
 
-        if (token_node->token->type == identifier_token){
+        if (token->type == identifier_token){
             // If argument is a variable
-            printf("MOVE TF@__arg%d LF@%s\n", arg_count, token_node->token->data);
+            ir_add2(gen->code, IR_MOVE, ir_var_n(IR_TF, "__arg", arg_count), ir_lf(ast_postfix_symbol(ast, arg, 0)->name));
         }
-        else if (token_node->token->type == int_token){
+        else if (token->type == int_token){
             // If argument is an int literal
-            printf("MOVE TF@__arg%d int@%s\n", arg_count, token_node->token->data);
+            ir_add2(gen->code, IR_MOVE, ir_var_n(IR_TF, "__arg", arg_count), ir_int_const(token->int_value));
         }
-        else if (token_node->token->type == float_token){
+        else if (token->type == float_token){
             // If argument is a float literal
-            printf("MOVE TF@__arg%d float@%s\n", arg_count, token_node->token->data);
+            ir_add2(gen->code, IR_MOVE, ir_var_n(IR_TF, "__arg", arg_count), ir_float_const(token->float_value));
         }
-        else if (token_node->token->type == string_token){
+        else if (token->type == string_token){
             // If argument is a string literal
-            char *escaped_str_temp = escape_string(token_node->token->data);
-            printf("MOVE TF@__arg%d string@%s\n", arg_count, escaped_str_temp);
-            free(escaped_str_temp);
-        }
-
-        // Move to the next token
-        token_node = next_node(ast);
-
-        // Skip ',' if present
-        if(strcmp(token_node->token->data, ",") == 0){
-            token_node = next_node(ast);
+            ir_add2(gen->code, IR_MOVE, ir_var_n(IR_TF, "__arg", arg_count), ir_string_text(token->text, token->text_length));
         }
 
         arg_count++;
     }
-    // token = ')'
-
-    // Save __decl_cnt value on the stack and reset it to 0 for new function
-    printf("PUSHS GF@__decl_cnt\n");
-    printf("MOVE GF@__decl_cnt int@0\n");
-    
-    printf("PUSHFRAME\n");
-    printf("CALL %s\n", function_name);
-
-    token_node = next_node(ast); // skip ')'
-    token_node = next_node(ast); // skip ';'
-}
-
-// Converts escape sequences to \xyz format
-char *escape_string(const char *input) {
-
-    size_t input_len = strlen(input);
-    // Allocates enough space: worst case every character is escaped as \xyz
-    size_t max_len = (input_len * 4) + 1;
-    char *escaped = malloc(sizeof(char)*max_len);
-    if (escaped == NULL) {
-        fprintf(stderr, "Memory allocation failed in escape_string\n");
-        exit(99);
-    }
 
-    size_t j = 0; // Index for escaped string
-
-    for (size_t i = 0; i < input_len; i++) {
-        unsigned char c = input[i];
-        // Check if character needs to be escaped
-        if (c <= 32 || c == 35 || c == 92) {
-            escaped[j++] = '\\';
-            escaped[j++] = '0';
-            escaped[j++] = '0' + (c / 10) % 10;
-            escaped[j++] = '0' + c % 10;
-        } else {
-            escaped[j++] = c;
-        }
-    }
-
-    escaped[j] = '\0'; // Null-terminate the string
-    return escaped;
+    ir_add0(gen->code, IR_PUSHFRAME);
+    ir_add1(gen->code, IR_CALL, ir_label_name(function_name));
 }
 
 // Generates definition of the function
 // pub fn ID (parameters) <return TYPE> {
-void generate_function_definition(ASTNode *token_node, AST *ast) {
-
-    token_node = next_node(ast); // skip 'pub'
-    token_node = next_node(ast); // <- function name, skip 'fn'
+void generate_function_definition(AST *ast, ast_index_t node, codegen_t *gen) {
 
     // LABEL function_name
-    printf("LABEL %s\n", token_node->token->data);
+    ir_add1(gen->code, IR_LABEL, ir_label_name(ast->symbol[node]->name));
 
-    // When printing new function definition, reset both counters to 0
-    printf("MOVE GF@__decl_cnt int@0\n");
-    global_decl_cnt = 0;
-
-    token_node = next_node(ast); // skip 'function_name'
-    token_node = next_node(ast); // <- parameter or ')', skip '('
+    // Names of locals are counted for every function
+    gen->function_cnt++;
 
     // Going through all the parameters and initializes them with the values from function call
     int param_idx = 0;
-    while(strcmp(token_node->token->data, ")") != 0){
+    for (ast_index_t param = ast->child[node]; ast->type[param] == node_param; param = ast->next[param]){
         // Parameter: <id> : <type>
-        char *param_name = token_node->token->data; // Store identifier
-
-        token_node = next_node(ast); // <- ':', skip "ID"
-        token_node = next_node(ast); // <- type, skip ':'
-        
-        printf("DEFVAR LF@%s\n", param_name);
+        generate_local_definition(ast->symbol[param], gen);
 
-        printf("MOVE LF@%s LF@__arg%d\n", param_name, param_idx);
+        ir_add2(gen->code, IR_MOVE, ir_lf(ast->symbol[param]->name), ir_var_n(IR_LF, "__arg", param_idx));
         param_idx++;
-
-        // Move to ',' or ')'
-        token_node = next_node(ast); // <- ',' or ')'
-
-        // Skip ','
-        if(strcmp(token_node->token->data, ",") == 0){
-            token_node = next_node(ast); // go to next parameter
-        }
     }
 
-    // pub fn ID (parametry) <return TYPE> {
-    token_node = next_node(ast); // skip ')'
-    token_node = next_node(ast); // <- '{', skip return type
-    token_node = next_node(ast); // <- skip '{'
+    // All variables of function body are defined here, declarations in loops do not define them again
+    ast_index_t body = ast_last_child(ast, node);
+    generate_local_definitions(ast, ast->child[body], gen);
 
     // generate function definition block
-    generate_code_for_line(token_node, ast);
-    token_node = ast->active;
+    generate_block(ast, ast->child[body], gen);
 
-    // "return" or '}'
-    generate_function_return(token_node, ast);
+    // Block ending with return has already returned
+    ast_index_t last = ast_last_child(ast, body);
+    if (last == AST_NONE || ast->type[last] != node_return){
+        ir_add0(gen->code, IR_POPFRAME);
+        ir_add0(gen->code, IR_RETURN);
+    }
+    generate_flush(gen);
+}
+
+// Defines variables declared in the list of statements and in nested blocks
+void generate_local_definitions(AST *ast, ast_index_t node, codegen_t *gen){
+    for (; node != AST_NONE; node = ast->next[node]){
+        if (ast->type[node] == node_var_decl){
+            generate_local_definition(ast->symbol[node], gen);
+        }
+        else if (ast->type[node] == node_if || ast->type[node] == node_while){
+            // if (cond) |y|, while (cond) |y|
+            if (ast->payload[node].token != NULL){
+                generate_local_definition(ast->symbol[node], gen);
+            }
+            // Blocks follow the condition, then and else of if, body of while
+            for (ast_index_t block = ast->next[ast->child[node]]; block != AST_NONE; block = ast->next[block]){
+                generate_local_definitions(ast, ast->child[block], gen);
+            }
+        }
+    }
+}
+
+// Defines local variable of current function
+// Variables of sibling blocks may have the same name, later ones are renamed to name$n
+void generate_local_definition(ht_item_t *symbol, codegen_t *gen){
+    if (gen->name_function[symbol->id] != gen->function_cnt){
+        gen->name_function[symbol->id] = gen->function_cnt;
+        gen->name_uses[symbol->id] = 0;
+    }
+    else {
+        // $ cannot be part of identifier, so new name does not collide with any other
+        uint32_t n = ++gen->name_uses[symbol->id];
+        int length = snprintf(NULL, 0, "%s$%" PRIu32, symbol->name, n);
+        char *name = arena_alloc(gen->arena, length + 1);
+        snprintf(name, length + 1, "%s$%" PRIu32, symbol->name, n);
+        symbol->name = name;
+    }
+    ir_add1(gen->code, IR_DEFVAR, ir_lf(symbol->name));
 }
 
 // Generates return for function
-void generate_function_return(ASTNode *token_node, AST *ast) {
+void generate_function_return(AST *ast, ast_index_t node, codegen_t *gen) {
     
-    if (strcmp(token_node->token->data, "}") != 0){ // true if function has return keyword
-        token_node = next_node(ast); // Skip 'return'
-
-        if (strcmp(token_node->token->data, ";") != 0) {    // true if there is expression after "return keyword"
-            // Generate code for the return expression
-            generate_expression(token_node, ast);
-            token_node = ast->active;
-        }
-        token_node = next_node(ast);    // skip ';'
+    if (ast->child[node] != AST_NONE) {    // true if there is expression after "return keyword"
+        // Generate code for the return expression
+        generate_expression(ast, ast->child[node], gen);
     }
-    // token = '}'
 
     // The result is on top of the stack
     // No need to do anything else, just call RETURN
-    printf("POPFRAME\n");
-    printf("RETURN\n");
+    ir_add0(gen->code, IR_POPFRAME);
+    ir_add0(gen->code, IR_RETURN);
 }
 
 // Generates function definition of all the built-in functions
-void generate_builtin_functions(){
+void generate_builtin_functions(codegen_t *gen){
 /************************  Functions for reading/writing  ************************/
     // pub fn ifj.readstr() ?[]u8
-    printf("LABEL ifj$readstr\n");
+    ir_add1(gen->code, IR_LABEL, ir_label_name("ifj$readstr"));
     
     // Define local variables
-    printf("DEFVAR LF@__retval\n");         // The read string
-    printf("DEFVAR LF@__type\n");           // Type of the read value
+    ir_add1(gen->code, IR_DEFVAR, ir_lf("__retval"));         // The read string
+    ir_add1(gen->code, IR_DEFVAR, ir_lf("__type"));           // Type of the read value
     
     // Read input as string
-    printf("READ LF@__retval string\n");
+    ir_add2(gen->code, IR_READ, ir_lf("__retval"), ir_type_name("string"));
 
     // Check if input is of type string
-    printf("TYPE LF@__type LF@__retval\n");
-    printf("JUMPIFEQ ifj_readstr_end LF@__type string@string\n");
+    ir_add2(gen->code, IR_TYPE, ir_lf("__type"), ir_lf("__retval"));
+    ir_add3(gen->code, IR_JUMPIFEQ, ir_label_name("ifj_readstr_end"), ir_lf("__type"), ir_string_const("string"));
     // If not, set return value to nil
-    printf("MOVE LF@__retval nil@nil\n");
+    ir_add2(gen->code, IR_MOVE, ir_lf("__retval"), ir_nil_const());
 
-    printf("LABEL ifj_readstr_end\n");
-    printf("PUSHS LF@__retval\n");
-    printf("POPFRAME\n");
-    printf("RETURN\n\n");
+    ir_add1(gen->code, IR_LABEL, ir_label_name("ifj_readstr_end"));
+    ir_add1(gen->code, IR_PUSHS, ir_lf("__retval"));
+    ir_add0(gen->code, IR_POPFRAME);
+    ir_add0(gen->code, IR_RETURN);
 
 // **********************************************************
     // pub fn ifj.readi32() ?i32
-    printf("LABEL ifj$readi32\n");
+    ir_add1(gen->code, IR_LABEL, ir_label_name("ifj$readi32"));
 
-    printf("DEFVAR LF@__retval\n");
-    printf("DEFVAR LF@__type\n");
+    ir_add1(gen->code, IR_DEFVAR, ir_lf("__retval"));
+    ir_add1(gen->code, IR_DEFVAR, ir_lf("__type"));
 
-    printf("READ LF@__retval int\n");
-    printf("TYPE LF@__type LF@__retval\n");
+    ir_add2(gen->code, IR_READ, ir_lf("__retval"), ir_type_name("int"));
+    ir_add2(gen->code, IR_TYPE, ir_lf("__type"), ir_lf("__retval"));
 
-    printf("JUMPIFEQ ifj_readi32_end LF@__type string@int\n");
-    printf("MOVE LF@__retval nil@nil\n");
+    ir_add3(gen->code, IR_JUMPIFEQ, ir_label_name("ifj_readi32_end"), ir_lf("__type"), ir_string_const("int"));
+    ir_add2(gen->code, IR_MOVE, ir_lf("__retval"), ir_nil_const());
 
-    printf("LABEL ifj_readi32_end\n");
-    printf("PUSHS LF@__retval\n");
-    printf("POPFRAME\n");
-    printf("RETURN\n");
+    ir_add1(gen->code, IR_LABEL, ir_label_name("ifj_readi32_end"));
+    ir_add1(gen->code, IR_PUSHS, ir_lf("__retval"));
+    ir_add0(gen->code, IR_POPFRAME);
+    ir_add0(gen->code, IR_RETURN);
 
 // **********************************************************
     // pub fn ifj.readf64() ?f64
-    printf("LABEL ifj$readf64\n");
+    ir_add1(gen->code, IR_LABEL, ir_label_name("ifj$readf64"));
 
-    printf("DEFVAR LF@__retval\n");
-    printf("DEFVAR LF@__type\n");
+    ir_add1(gen->code, IR_DEFVAR, ir_lf("__retval"));
+    ir_add1(gen->code, IR_DEFVAR, ir_lf("__type"));
 
-    printf("READ LF@__retval float\n");
-    printf("TYPE LF@__type LF@__retval\n");
+    ir_add2(gen->code, IR_READ, ir_lf("__retval"), ir_type_name("float"));
+    ir_add2(gen->code, IR_TYPE, ir_lf("__type"), ir_lf("__retval"));
 
-    printf("JUMPIFEQ ifj_readf64_end LF@__type string@float\n");
-    printf("MOVE LF@__retval nil@nil\n");
+    ir_add3(gen->code, IR_JUMPIFEQ, ir_label_name("ifj_readf64_end"), ir_lf("__type"), ir_string_const("float"));
+    ir_add2(gen->code, IR_MOVE, ir_lf("__retval"), ir_nil_const());
 
-    printf("LABEL ifj_readf64_end\n");
-    printf("PUSHS LF@__retval\n");
-    printf("POPFRAME\n");
-    printf("RETURN\n");
+    ir_add1(gen->code, IR_LABEL, ir_label_name("ifj_readf64_end"));
+    ir_add1(gen->code, IR_PUSHS, ir_lf("__retval"));
+    ir_add0(gen->code, IR_POPFRAME);
+    ir_add0(gen->code, IR_RETURN);
 
 // **********************************************************
     // pub fn ifj.write(term) void
-    printf("LABEL ifj$write\n");
-    printf("DEFVAR LF@__term\n");
-    printf("DEFVAR LF@__type\n");
+    ir_add1(gen->code, IR_LABEL, ir_label_name("ifj$write"));
+    ir_add1(gen->code, IR_DEFVAR, ir_lf("__term"));
+    ir_add1(gen->code, IR_DEFVAR, ir_lf("__type"));
 
-    printf("MOVE LF@__term LF@__arg0\n");
-    printf("TYPE LF@__type LF@__term\n");
+    ir_add2(gen->code, IR_MOVE, ir_lf("__term"), ir_lf("__arg0"));
+    ir_add2(gen->code, IR_TYPE, ir_lf("__type"), ir_lf("__term"));
 
-    printf("JUMPIFEQ ifj_write_nil LF@__type string@nil\n"); // if the value is nill
+    ir_add3(gen->code, IR_JUMPIFEQ, ir_label_name("ifj_write_nil"), ir_lf("__type"), ir_string_const("nil")); // if the value is nill
 
-    printf("WRITE LF@__term\n");
-    printf("JUMP ifj_write_end\n");
+    ir_add1(gen->code, IR_WRITE, ir_lf("__term"));
+    ir_add1(gen->code, IR_JUMP, ir_label_name("ifj_write_end"));
     
-    printf("LABEL ifj_write_nil\n");
-    printf("WRITE string@null\n");
+    ir_add1(gen->code, IR_LABEL, ir_label_name("ifj_write_nil"));
+    ir_add1(gen->code, IR_WRITE, ir_string_const("null"));
 
-    printf("LABEL ifj_write_end\n");
-    printf("POPFRAME\n");
-    printf("RETURN\n\n");
+    ir_add1(gen->code, IR_LABEL, ir_label_name("ifj_write_end"));
+    ir_add0(gen->code, IR_POPFRAME);
+    ir_add0(gen->code, IR_RETURN);
 
 
 /***************************  Type conversion functions  ****************************/
     /// pub fn ifj.i2f(term ∶ i32) f64
-    printf("LABEL ifj$i2f\n");
+    ir_add1(gen->code, IR_LABEL, ir_label_name("ifj$i2f"));
     
-    printf("DEFVAR LF@__retval\n");
-    printf("INT2FLOAT LF@__retval LF@__arg0\n");
+    ir_add1(gen->code, IR_DEFVAR, ir_lf("__retval"));
+    ir_add2(gen->code, IR_INT2FLOAT, ir_lf("__retval"), ir_lf("__arg0"));
     
     // Push the result onto the stack
-    printf("PUSHS LF@__retval\n");
-    printf("POPFRAME\n");
-    printf("RETURN\n\n");
+    ir_add1(gen->code, IR_PUSHS, ir_lf("__retval"));
+    ir_add0(gen->code, IR_POPFRAME);
+    ir_add0(gen->code, IR_RETURN);
 
 // **********************************************************
     // pub fn ifj.f2i(term ∶ f64) i32
-    printf("LABEL ifj$f2i\n");
+    ir_add1(gen->code, IR_LABEL, ir_label_name("ifj$f2i"));
     
-    printf("DEFVAR LF@__retval\n");
-    printf("FLOAT2INT LF@__retval LF@__arg0\n");
+    ir_add1(gen->code, IR_DEFVAR, ir_lf("__retval"));
+    ir_add2(gen->code, IR_FLOAT2INT, ir_lf("__retval"), ir_lf("__arg0"));
     
     // Push the result onto the stack
-    printf("PUSHS LF@__retval\n");
-    printf("POPFRAME\n");
-    printf("RETURN\n\n");
+    ir_add1(gen->code, IR_PUSHS, ir_lf("__retval"));
+    ir_add0(gen->code, IR_POPFRAME);
+    ir_add0(gen->code, IR_RETURN);
 
 
 /***********************  Functions for strings  *************************/
     // pub fn ifj.string(term) []u8
-    printf("LABEL ifj$string\n");
+    ir_add1(gen->code, IR_LABEL, ir_label_name("ifj$string"));
 
     // Push the term onto the stack
-    printf("PUSHS LF@__arg0\n");
-    printf("POPFRAME\n");
-    printf("RETURN\n\n");
+    ir_add1(gen->code, IR_PUSHS, ir_lf("__arg0"));
+    ir_add0(gen->code, IR_POPFRAME);
+    ir_add0(gen->code, IR_RETURN);
 
 // **********************************************************
     // pub fn ifj.length(𝑠 : []u8) i32
-    printf("LABEL ifj$length\n");
+    ir_add1(gen->code, IR_LABEL, ir_label_name("ifj$length"));
     
-    printf("DEFVAR LF@__s\n");
-    printf("MOVE LF@__s LF@__arg0\n");
+    ir_add1(gen->code, IR_DEFVAR, ir_lf("__s"));
+    ir_add2(gen->code, IR_MOVE, ir_lf("__s"), ir_lf("__arg0"));
     
-    printf("DEFVAR LF@__retval\n");
-    printf("STRLEN LF@__retval LF@__s\n");
+    ir_add1(gen->code, IR_DEFVAR, ir_lf("__retval"));
+    ir_add2(gen->code, IR_STRLEN, ir_lf("__retval"), ir_lf("__s"));
     
     // Push the result onto the stack
-    printf("PUSHS LF@__retval\n");
-    printf("POPFRAME\n");
-    printf("RETURN\n\n");
+    ir_add1(gen->code, IR_PUSHS, ir_lf("__retval"));
+    ir_add0(gen->code, IR_POPFRAME);
+    ir_add0(gen->code, IR_RETURN);
 
 // **********************************************************
     // pub fn ifj.concat(𝑠1 : []u8, 𝑠2 : []u8) []u8
-    printf("LABEL ifj$concat\n");
+    ir_add1(gen->code, IR_LABEL, ir_label_name("ifj$concat"));
     
-    printf("DEFVAR LF@__s1\n");
-    printf("DEFVAR LF@__s2\n");
-    printf("DEFVAR LF@__retval\n");
+    ir_add1(gen->code, IR_DEFVAR, ir_lf("__s1"));
+    ir_add1(gen->code, IR_DEFVAR, ir_lf("__s2"));
+    ir_add1(gen->code, IR_DEFVAR, ir_lf("__retval"));
 
-    printf("MOVE LF@__s1 LF@__arg0\n");
-    printf("MOVE LF@__s2 LF@__arg1\n");    
-    printf("CONCAT LF@__retval LF@__s1 LF@__s2\n");
+    ir_add2(gen->code, IR_MOVE, ir_lf("__s1"), ir_lf("__arg0"));
+    ir_add2(gen->code, IR_MOVE, ir_lf("__s2"), ir_lf("__arg1"));    
+    ir_add3(gen->code, IR_CONCAT, ir_lf("__retval"), ir_lf("__s1"), ir_lf("__s2"));
     
     // Push the result onto the stack
-    printf("PUSHS LF@__retval\n");
-    printf("POPFRAME\n");
-    printf("RETURN\n\n");
+    ir_add1(gen->code, IR_PUSHS, ir_lf("__retval"));
+    ir_add0(gen->code, IR_POPFRAME);
+    ir_add0(gen->code, IR_RETURN);
 
 // **********************************************************
     // pub fn ifj.substring(𝑠 : []u8, 𝑖 : i32, 𝑗 : i32) ?[]u8
-    printf("LABEL ifj$substring\n");
+    ir_add1(gen->code, IR_LABEL, ir_label_name("ifj$substring"));
 
     // Define local variables
-    printf("DEFVAR LF@__s\n");
-    printf("DEFVAR LF@__i\n");
-    printf("DEFVAR LF@__j\n");
+    ir_add1(gen->code, IR_DEFVAR, ir_lf("__s"));
+    ir_add1(gen->code, IR_DEFVAR, ir_lf("__i"));
+    ir_add1(gen->code, IR_DEFVAR, ir_lf("__j"));
     
-    printf("MOVE LF@__s LF@__arg0\n");
-    printf("MOVE LF@__i LF@__arg1\n");
-    printf("MOVE LF@__j LF@__arg2\n");
+    ir_add2(gen->code, IR_MOVE, ir_lf("__s"), ir_lf("__arg0"));
+    ir_add2(gen->code, IR_MOVE, ir_lf("__i"), ir_lf("__arg1"));
+    ir_add2(gen->code, IR_MOVE, ir_lf("__j"), ir_lf("__arg2"));
 
-    printf("DEFVAR LF@__retval\n");
-    printf("DEFVAR LF@__len\n");
-    printf("DEFVAR LF@__cond\n");
-    printf("DEFVAR LF@__substring\n");
-    printf("DEFVAR LF@__tmp_char\n");
+    ir_add1(gen->code, IR_DEFVAR, ir_lf("__retval"));
+    ir_add1(gen->code, IR_DEFVAR, ir_lf("__len"));
+    ir_add1(gen->code, IR_DEFVAR, ir_lf("__cond"));
+    ir_add1(gen->code, IR_DEFVAR, ir_lf("__substring"));
+    ir_add1(gen->code, IR_DEFVAR, ir_lf("__tmp_char"));
 
     // Check for error conditions
     // If i < 0
-    printf("LT LF@__cond LF@__i int@0\n");
-    printf("JUMPIFEQ ifj_substring_error LF@__cond bool@true\n");
+    ir_add3(gen->code, IR_LT, ir_lf("__cond"), ir_lf("__i"), ir_int_const(0));
+    ir_add3(gen->code, IR_JUMPIFEQ, ir_label_name("ifj_substring_error"), ir_lf("__cond"), ir_bool_const(true));
 
     // If j < 0
-    printf("LT LF@__cond LF@__j int@0\n");
-    printf("JUMPIFEQ ifj_substring_error LF@__cond bool@true\n");
+    ir_add3(gen->code, IR_LT, ir_lf("__cond"), ir_lf("__j"), ir_int_const(0));
+    ir_add3(gen->code, IR_JUMPIFEQ, ir_label_name("ifj_substring_error"), ir_lf("__cond"), ir_bool_const(true));
 
     // If i > j
-    printf("GT LF@__cond LF@__i LF@__j\n");
-    printf("JUMPIFEQ ifj_substring_error LF@__cond bool@true\n");
+    ir_add3(gen->code, IR_GT, ir_lf("__cond"), ir_lf("__i"), ir_lf("__j"));
+    ir_add3(gen->code, IR_JUMPIFEQ, ir_label_name("ifj_substring_error"), ir_lf("__cond"), ir_bool_const(true));
 
     // Get the length of the string s
-    printf("STRLEN LF@__len LF@__s\n");
+    ir_add2(gen->code, IR_STRLEN, ir_lf("__len"), ir_lf("__s"));
 
     // If i >= length(s)
-    printf("LT LF@__cond LF@__i LF@__len\n");
-    printf("JUMPIFNEQ ifj_substring_error LF@__cond bool@true\n");
+    ir_add3(gen->code, IR_LT, ir_lf("__cond"), ir_lf("__i"), ir_lf("__len"));
+    ir_add3(gen->code, IR_JUMPIFNEQ, ir_label_name("ifj_substring_error"), ir_lf("__cond"), ir_bool_const(true));
 
     // If j > length(s)
-    printf("GT LF@__cond LF@__j LF@__len\n");
-    printf("JUMPIFEQ ifj_substring_error LF@__cond bool@true\n");
+    ir_add3(gen->code, IR_GT, ir_lf("__cond"), ir_lf("__j"), ir_lf("__len"));
+    ir_add3(gen->code, IR_JUMPIFEQ, ir_label_name("ifj_substring_error"), ir_lf("__cond"), ir_bool_const(true));
 
     // Initialize empty string
-    printf("MOVE LF@__substring string@\n");
+    ir_add2(gen->code, IR_MOVE, ir_lf("__substring"), ir_string_const(""));
 
     // while loop
-    printf("LABEL ifj_substring_while\n");
-    printf("JUMPIFEQ ifj_substring_while_end LF@__i LF@__j\n");
+    ir_add1(gen->code, IR_LABEL, ir_label_name("ifj_substring_while"));
+    ir_add3(gen->code, IR_JUMPIFEQ, ir_label_name("ifj_substring_while_end"), ir_lf("__i"), ir_lf("__j"));
 
-    printf("GETCHAR LF@__tmp_char LF@__s LF@__i\n");
-    printf("CONCAT LF@__substring LF@__substring LF@__tmp_char\n");
+    ir_add3(gen->code, IR_GETCHAR, ir_lf("__tmp_char"), ir_lf("__s"), ir_lf("__i"));
+    ir_add3(gen->code, IR_CONCAT, ir_lf("__substring"), ir_lf("__substring"), ir_lf("__tmp_char"));
 
-    printf("ADD LF@__i LF@__i int@1\n"); // i++
-    printf("JUMP ifj_substring_while\n");
+    ir_add3(gen->code, IR_ADD, ir_lf("__i"), ir_lf("__i"), ir_int_const(1)); // i++
+    ir_add1(gen->code, IR_JUMP, ir_label_name("ifj_substring_while"));
 
     // Error label: Return nil
-    printf("LABEL ifj_substring_error\n");
-    printf("MOVE LF@__retval nil@nil\n");
-    printf("JUMP ifj_substring_end\n");
+    ir_add1(gen->code, IR_LABEL, ir_label_name("ifj_substring_error"));
+    ir_add2(gen->code, IR_MOVE, ir_lf("__retval"), ir_nil_const());
+    ir_add1(gen->code, IR_JUMP, ir_label_name("ifj_substring_end"));
 
-    printf("LABEL ifj_substring_while_end\n");
-    printf("MOVE LF@__retval LF@__substring\n");
-    printf("LABEL ifj_substring_end\n");
+    ir_add1(gen->code, IR_LABEL, ir_label_name("ifj_substring_while_end"));
+    ir_add2(gen->code, IR_MOVE, ir_lf("__retval"), ir_lf("__substring"));
+    ir_add1(gen->code, IR_LABEL, ir_label_name("ifj_substring_end"));
 
-    printf("PUSHS LF@__retval\n");
-    printf("POPFRAME\n");
-    printf("RETURN\n\n");
+    ir_add1(gen->code, IR_PUSHS, ir_lf("__retval"));
+    ir_add0(gen->code, IR_POPFRAME);
+    ir_add0(gen->code, IR_RETURN);
 
 // **********************************************************
     // pub fn ifj.strcmp(𝑠1 : []u8, 𝑠2 : []u8) i32
-    printf("LABEL ifj$strcmp\n");
+    ir_add1(gen->code, IR_LABEL, ir_label_name("ifj$strcmp"));
 
     // Define local variables
-    printf("DEFVAR LF@__s1\n");
-    printf("DEFVAR LF@__s2\n");
-    printf("MOVE LF@__s1 LF@__arg0\n");
-    printf("MOVE LF@__s2 LF@__arg1\n");
-
-    printf("DEFVAR LF@__len1\n");
-    printf("DEFVAR LF@__len2\n");
-    printf("DEFVAR LF@__min_len\n");
-    printf("DEFVAR LF@__i\n");
-    printf("DEFVAR LF@__char1\n");
-    printf("DEFVAR LF@__char2\n");
-    printf("DEFVAR LF@__cmp_res\n");
-    printf("DEFVAR LF@__retval\n");
+    ir_add1(gen->code, IR_DEFVAR, ir_lf("__s1"));
+    ir_add1(gen->code, IR_DEFVAR, ir_lf("__s2"));
+    ir_add2(gen->code, IR_MOVE, ir_lf("__s1"), ir_lf("__arg0"));
+    ir_add2(gen->code, IR_MOVE, ir_lf("__s2"), ir_lf("__arg1"));
+
+    ir_add1(gen->code, IR_DEFVAR, ir_lf("__len1"));
+    ir_add1(gen->code, IR_DEFVAR, ir_lf("__len2"));
+    ir_add1(gen->code, IR_DEFVAR, ir_lf("__min_len"));
+    ir_add1(gen->code, IR_DEFVAR, ir_lf("__i"));
+    ir_add1(gen->code, IR_DEFVAR, ir_lf("__char1"));
+    ir_add1(gen->code, IR_DEFVAR, ir_lf("__char2"));
+    ir_add1(gen->code, IR_DEFVAR, ir_lf("__cmp_res"));
+    ir_add1(gen->code, IR_DEFVAR, ir_lf("__retval"));
 
     
-    printf("STRLEN LF@__len1 LF@__s1\n");
-    printf("STRLEN LF@__len2 LF@__s2\n");
+    ir_add2(gen->code, IR_STRLEN, ir_lf("__len1"), ir_lf("__s1"));
+    ir_add2(gen->code, IR_STRLEN, ir_lf("__len2"), ir_lf("__s2"));
 
     // Determine the minimum length
-    printf("LT LF@__cmp_res LF@__len1 LF@__len2\n");
-    printf("JUMPIFEQ ifj_strcmp_set_min_len1 LF@__cmp_res bool@true\n");
-    printf("MOVE LF@__min_len LF@__len2\n");
-    printf("JUMP ifj_strcmp_start\n");
-    printf("LABEL ifj_strcmp_set_min_len1\n");
-    printf("MOVE LF@__min_len LF@__len1\n");
+    ir_add3(gen->code, IR_LT, ir_lf("__cmp_res"), ir_lf("__len1"), ir_lf("__len2"));
+    ir_add3(gen->code, IR_JUMPIFEQ, ir_label_name("ifj_strcmp_set_min_len1"), ir_lf("__cmp_res"), ir_bool_const(true));
+    ir_add2(gen->code, IR_MOVE, ir_lf("__min_len"), ir_lf("__len2"));
+    ir_add1(gen->code, IR_JUMP, ir_label_name("ifj_strcmp_start"));
+    ir_add1(gen->code, IR_LABEL, ir_label_name("ifj_strcmp_set_min_len1"));
+    ir_add2(gen->code, IR_MOVE, ir_lf("__min_len"), ir_lf("__len1"));
 
-    printf("LABEL ifj_strcmp_start\n");
-    printf("MOVE LF@__i int@0\n"); // i = 0
+    ir_add1(gen->code, IR_LABEL, ir_label_name("ifj_strcmp_start"));
+    ir_add2(gen->code, IR_MOVE, ir_lf("__i"), ir_int_const(0)); // i = 0
 
-    printf("LABEL ifj_strcmp_loop\n");
+    ir_add1(gen->code, IR_LABEL, ir_label_name("ifj_strcmp_loop"));
     // Loop condition: __i < __min_len
-    printf("LT LF@__cmp_res LF@__i LF@__min_len\n");
-    printf("JUMPIFEQ ifj_strcmp_compare_chars LF@__cmp_res bool@true\n");
-    printf("JUMP ifj_strcmp_length_compare\n");
+    ir_add3(gen->code, IR_LT, ir_lf("__cmp_res"), ir_lf("__i"), ir_lf("__min_len"));
+    ir_add3(gen->code, IR_JUMPIFEQ, ir_label_name("ifj_strcmp_compare_chars"), ir_lf("__cmp_res"), ir_bool_const(true));
+    ir_add1(gen->code, IR_JUMP, ir_label_name("ifj_strcmp_length_compare"));
 
-    printf("LABEL ifj_strcmp_compare_chars\n");
+    ir_add1(gen->code, IR_LABEL, ir_label_name("ifj_strcmp_compare_chars"));
     // Get characters at position __i
-    printf("GETCHAR LF@__char1 LF@__s1 LF@__i\n");
-    printf("GETCHAR LF@__char2 LF@__s2 LF@__i\n");
+    ir_add3(gen->code, IR_GETCHAR, ir_lf("__char1"), ir_lf("__s1"), ir_lf("__i"));
+    ir_add3(gen->code, IR_GETCHAR, ir_lf("__char2"), ir_lf("__s2"), ir_lf("__i"));
     // Compare characters
-    printf("GT LF@__cmp_res LF@__char1 LF@__char2\n");
-    printf("JUMPIFEQ ifj_strcmp_s1_greater LF@__cmp_res bool@true\n");
-    printf("LT LF@__cmp_res LF@__char1 LF@__char2\n");
-    printf("JUMPIFEQ ifj_strcmp_s1_less LF@__cmp_res bool@true\n");
+    ir_add3(gen->code, IR_GT, ir_lf("__cmp_res"), ir_lf("__char1"), ir_lf("__char2"));
+    ir_add3(gen->code, IR_JUMPIFEQ, ir_label_name("ifj_strcmp_s1_greater"), ir_lf("__cmp_res"), ir_bool_const(true));
+    ir_add3(gen->code, IR_LT, ir_lf("__cmp_res"), ir_lf("__char1"), ir_lf("__char2"));
+    ir_add3(gen->code, IR_JUMPIFEQ, ir_label_name("ifj_strcmp_s1_less"), ir_lf("__cmp_res"), ir_bool_const(true));
     // Characters are equal, continue loop
-    printf("ADD LF@__i LF@__i int@1\n");
-    printf("JUMP ifj_strcmp_loop\n");
+    ir_add3(gen->code, IR_ADD, ir_lf("__i"), ir_lf("__i"), ir_int_const(1));
+    ir_add1(gen->code, IR_JUMP, ir_label_name("ifj_strcmp_loop"));
 
     // If s1 > s2
-    printf("LABEL ifj_strcmp_s1_greater\n");
-    printf("MOVE LF@__retval int@1\n");
-    printf("JUMP ifj_strcmp_end\n");
+    ir_add1(gen->code, IR_LABEL, ir_label_name("ifj_strcmp_s1_greater"));
+    ir_add2(gen->code, IR_MOVE, ir_lf("__retval"), ir_int_const(1));
+    ir_add1(gen->code, IR_JUMP, ir_label_name("ifj_strcmp_end"));
 
     // If s1 < s2
-    printf("LABEL ifj_strcmp_s1_less\n");
-    printf("MOVE LF@__retval int@-1\n");
-    printf("JUMP ifj_strcmp_end\n");
+    ir_add1(gen->code, IR_LABEL, ir_label_name("ifj_strcmp_s1_less"));
+    ir_add2(gen->code, IR_MOVE, ir_lf("__retval"), ir_int_const(-1));
+    ir_add1(gen->code, IR_JUMP, ir_label_name("ifj_strcmp_end"));
 
     // After loop, compare lengths
-    printf("LABEL ifj_strcmp_length_compare\n");
-    printf("EQ LF@__cmp_res LF@__len1 LF@__len2\n");
-    printf("JUMPIFEQ ifj_strcmp_equal LF@__cmp_res bool@true\n");
-    printf("GT LF@__cmp_res LF@__len1 LF@__len2\n");
-    printf("JUMPIFEQ ifj_strcmp_s1_greater LF@__cmp_res bool@true\n");
+    ir_add1(gen->code, IR_LABEL, ir_label_name("ifj_strcmp_length_compare"));
+    ir_add3(gen->code, IR_EQ, ir_lf("__cmp_res"), ir_lf("__len1"), ir_lf("__len2"));
+    ir_add3(gen->code, IR_JUMPIFEQ, ir_label_name("ifj_strcmp_equal"), ir_lf("__cmp_res"), ir_bool_const(true));
+    ir_add3(gen->code, IR_GT, ir_lf("__cmp_res"), ir_lf("__len1"), ir_lf("__len2"));
+    ir_add3(gen->code, IR_JUMPIFEQ, ir_label_name("ifj_strcmp_s1_greater"), ir_lf("__cmp_res"), ir_bool_const(true));
     // Else, s1 is less than s2
-    printf("JUMP ifj_strcmp_s1_less\n");
+    ir_add1(gen->code, IR_JUMP, ir_label_name("ifj_strcmp_s1_less"));
 
-    printf("LABEL ifj_strcmp_equal\n");
-    printf("MOVE LF@__retval int@0\n");
-    printf("JUMP ifj_strcmp_end\n");
+    ir_add1(gen->code, IR_LABEL, ir_label_name("ifj_strcmp_equal"));
+    ir_add2(gen->code, IR_MOVE, ir_lf("__retval"), ir_int_const(0));
+    ir_add1(gen->code, IR_JUMP, ir_label_name("ifj_strcmp_end"));
 
-    printf("LABEL ifj_strcmp_end\n");
-    printf("PUSHS LF@__retval\n");
-    printf("POPFRAME\n");
-    printf("RETURN\n\n");
+    ir_add1(gen->code, IR_LABEL, ir_label_name("ifj_strcmp_end"));
+    ir_add1(gen->code, IR_PUSHS, ir_lf("__retval"));
+    ir_add0(gen->code, IR_POPFRAME);
+    ir_add0(gen->code, IR_RETURN);
 
 // **********************************************************
     // pub fn ifj.ord(𝑠 : []u8, 𝑖 : i32) i32
-    printf("LABEL ifj$ord\n");
+    ir_add1(gen->code, IR_LABEL, ir_label_name("ifj$ord"));
 
     // Define local variables
-    printf("DEFVAR LF@__s\n");
-    printf("DEFVAR LF@__i\n");
-    printf("MOVE LF@__s LF@__arg0\n");
-    printf("MOVE LF@__i LF@__arg1\n");
+    ir_add1(gen->code, IR_DEFVAR, ir_lf("__s"));
+    ir_add1(gen->code, IR_DEFVAR, ir_lf("__i"));
+    ir_add2(gen->code, IR_MOVE, ir_lf("__s"), ir_lf("__arg0"));
+    ir_add2(gen->code, IR_MOVE, ir_lf("__i"), ir_lf("__arg1"));
 
-    printf("DEFVAR LF@__len\n");
-    printf("DEFVAR LF@__char\n");
-    printf("DEFVAR LF@__retval\n");
-    printf("DEFVAR LF@__cond\n");
+    ir_add1(gen->code, IR_DEFVAR, ir_lf("__len"));
+    ir_add1(gen->code, IR_DEFVAR, ir_lf("__char"));
+    ir_add1(gen->code, IR_DEFVAR, ir_lf("__retval"));
+    ir_add1(gen->code, IR_DEFVAR, ir_lf("__cond"));
 
-    printf("STRLEN LF@__len LF@__s\n");
+    ir_add2(gen->code, IR_STRLEN, ir_lf("__len"), ir_lf("__s"));
 
     // Default return value is 0
-    printf("MOVE LF@__retval int@0\n");
+    ir_add2(gen->code, IR_MOVE, ir_lf("__retval"), ir_int_const(0));
 
     // Check if __s is empty
-    printf("EQ LF@__cond LF@__len int@0\n");
-    printf("JUMPIFEQ ifj_ord_end LF@__cond bool@true\n");
+    ir_add3(gen->code, IR_EQ, ir_lf("__cond"), ir_lf("__len"), ir_int_const(0));
+    ir_add3(gen->code, IR_JUMPIFEQ, ir_label_name("ifj_ord_end"), ir_lf("__cond"), ir_bool_const(true));
 
     // Check if i < 0 or i >= len(s)
-    printf("LT LF@__cond LF@__i int@0\n");
-    printf("JUMPIFEQ ifj_ord_end LF@__cond bool@true\n");
-    printf("GT LF@__cond LF@__i LF@__len\n");
-    printf("JUMPIFEQ ifj_ord_end LF@__cond bool@true\n");
-    printf("EQ LF@__cond LF@__i LF@__len\n");
-    printf("JUMPIFEQ ifj_ord_end LF@__cond bool@true\n");
+    ir_add3(gen->code, IR_LT, ir_lf("__cond"), ir_lf("__i"), ir_int_const(0));
+    ir_add3(gen->code, IR_JUMPIFEQ, ir_label_name("ifj_ord_end"), ir_lf("__cond"), ir_bool_const(true));
+    ir_add3(gen->code, IR_GT, ir_lf("__cond"), ir_lf("__i"), ir_lf("__len"));
+    ir_add3(gen->code, IR_JUMPIFEQ, ir_label_name("ifj_ord_end"), ir_lf("__cond"), ir_bool_const(true));
+    ir_add3(gen->code, IR_EQ, ir_lf("__cond"), ir_lf("__i"), ir_lf("__len"));
+    ir_add3(gen->code, IR_JUMPIFEQ, ir_label_name("ifj_ord_end"), ir_lf("__cond"), ir_bool_const(true));
 
     // Get character at position i and convert character to integer (ASCII value)
-    printf("STRI2INT LF@__retval LF@__s LF@__i\n");
+    ir_add3(gen->code, IR_STRI2INT, ir_lf("__retval"), ir_lf("__s"), ir_lf("__i"));
 
-    printf("LABEL ifj_ord_end\n");
-    printf("PUSHS LF@__retval\n");
-    printf("POPFRAME\n");
-    printf("RETURN\n\n");
+    ir_add1(gen->code, IR_LABEL, ir_label_name("ifj_ord_end"));
+    ir_add1(gen->code, IR_PUSHS, ir_lf("__retval"));
+    ir_add0(gen->code, IR_POPFRAME);
+    ir_add0(gen->code, IR_RETURN);
 
 // **********************************************************
     // pub fn ifj.chr(𝑖 : i32) []u8
-    printf("LABEL ifj$chr\n");
+    ir_add1(gen->code, IR_LABEL, ir_label_name("ifj$chr"));
 
     // Define local variables
-    printf("DEFVAR LF@__i\n");
-    printf("MOVE LF@__i LF@__arg0\n");
+    ir_add1(gen->code, IR_DEFVAR, ir_lf("__i"));
+    ir_add2(gen->code, IR_MOVE, ir_lf("__i"), ir_lf("__arg0"));
 
-    printf("DEFVAR LF@__retval\n");
+    ir_add1(gen->code, IR_DEFVAR, ir_lf("__retval"));
 
     // Convert integer to character
-    printf("INT2CHAR LF@__retval LF@__i\n");
+    ir_add2(gen->code, IR_INT2CHAR, ir_lf("__retval"), ir_lf("__i"));
 
     // Push the result onto the stack
-    printf("PUSHS LF@__retval\n");
-    printf("POPFRAME\n");
-    printf("RETURN\n");
+    ir_add1(gen->code, IR_PUSHS, ir_lf("__retval"));
+    ir_add0(gen->code, IR_POPFRAME);
+    ir_add0(gen->code, IR_RETURN);
 }
@@ -9,9 +9,10 @@
 #ifndef CODEGEN_H
 #define CODEGEN_H
 
-#include "ast.h"
+#include "compiler.h"
+#include "emit.h"
 
-// Function that calls all other necessarry functions and generates code for the given AST
-void generate_code(AST *ast);
+// Function that calls all other necessarry functions and generates code for AST of compiler into out
+void generate_code(compiler_t *compiler, emitter_t *out);
 
 #endif //CODEGEN_H
\ No newline at end of file
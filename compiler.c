@@ -0,0 +1,57 @@
+/*
+* Project: Implementacia prekladaca imperativneho jazyka IFJ2024
+*
+* @author: Jakub Hrdlicka <xhrdli18>
+*
+*/
+
+#include <string.h>
+#include <setjmp.h>
+#include "compiler.h"
+#include "semantics.h"
+#include "codegen.h"
+
+
+// Initialize compiler, parts that are not initialized yet stay zeroed for compiler_free
+void compiler_init(compiler_t *compiler){
+    arena_init(&compiler->arena, &compiler->diag);
+    intern_init(&compiler->intern, &compiler->arena);
+    lexer_init(&compiler->lexer, &compiler->arena, &compiler->intern, &compiler->diag);
+    compiler->ast = create_ast(&compiler->diag);
+}
+
+// Run all phases, error in any of them jumps back here
+int compiler_run(compiler_t *compiler, const char *source, size_t length, emitter_t *out){
+    memset(compiler, 0, sizeof(compiler_t));
+
+    jmp_buf jump;
+    if (setjmp(jump) != 0){
+        compiler->diag.jump = NULL;
+        return compiler->diag.code;
+    }
+    compiler->diag.jump = &jump;
+    out->diag = &compiler->diag;
+
+    compiler_init(compiler);
+    source_borrow(&compiler->lexer.source, source, length);
+
+    parse(compiler);
+    semantic_analysis(compiler);
+    generate_code(compiler, out);
+    emit_flush(out);
+
+    compiler->diag.jump = NULL;
+    return 0;
+}
+
+// Release everything owned by compiler
+void compiler_free(compiler_t *compiler){
+    if (compiler->ast != NULL){
+        destroy_ast(compiler->ast);
+        compiler->ast = NULL;
+    }
+    ir_free(&compiler->code);
+    lexer_free(&compiler->lexer);
+    intern_free(&compiler->intern);
+    arena_free(&compiler->arena);
+}
\ No newline at end of file
@@ -0,0 +1,41 @@
+/*
+* Project: Implementacia prekladaca imperativneho jazyka IFJ2024
+*
+* @author: Jakub Hrdlicka <xhrdli18>
+*
+*/
+
+#ifndef COMPILER_H
+#define COMPILER_H
+
+#include "diag.h"
+#include "emit.h"
+#include "arena.h"
+#include "intern.h"
+#include "lexer.h"
+#include "ast.h"
+#include "ir.h"
+
+// State of one compilation, passed through all phases
+// Compilations share no mutable state, so more of them can run in one process
+typedef struct compiler {
+    diag_t diag;            // first error, all phases stop at it
+    arena_t arena;          // tokens, identifiers and symbols, released at once
+    intern_table_t intern;  // identifiers of compiled source
+    lexer_t lexer;          // source and its cursor
+    AST *ast;
+    ir_code_t code;         // instructions of function being generated
+} compiler_t;
+
+// Compile source of given length into IFJcode24 emitted to out, out is flushed at the end
+// Returns 0, or exit code of the first error with its message in compiler->diag
+// Source is not copied, compiler_free has to be called in both cases
+int compiler_run(compiler_t *compiler, const char *source, size_t length, emitter_t *out);
+
+// Release everything owned by compiler
+void compiler_free(compiler_t *compiler);
+
+// Parse source loaded in lexer and build AST (syntakticka_analyza.c)
+void parse(compiler_t *compiler);
+
+#endif
\ No newline at end of file
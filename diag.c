@@ -0,0 +1,22 @@
+/*
+* Project: Implementacia prekladaca imperativneho jazyka IFJ2024
+*
+* @author: Jakub Hrdlicka <xhrdli18>
+*
+*/
+
+#include <stdarg.h>
+#include <stdio.h>
+#include "diag.h"
+
+
+// Record error and jump out of the running phase
+_Noreturn void diag_raise(diag_t *diag, int code, const char *format, ...){
+    va_list args;
+    va_start(args, format);
+    vsnprintf(diag->message, DIAG_MESSAGE_SIZE, format, args);
+    va_end(args);
+
+    diag->code = code;
+    longjmp(*diag->jump, 1);
+}
\ No newline at end of file
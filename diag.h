@@ -0,0 +1,27 @@
+/*
+* Project: Implementacia prekladaca imperativneho jazyka IFJ2024
+*
+* @author: Jakub Hrdlicka <xhrdli18>
+*
+*/
+
+#ifndef DIAG_H
+#define DIAG_H
+
+#include <setjmp.h>
+
+// Length of error message including NUL
+#define DIAG_MESSAGE_SIZE 256
+
+// First error of compilation
+// Phases do not return after error, diag_raise jumps back to compiler_run
+typedef struct diag {
+    jmp_buf *jump;      // where compilation continues after error
+    int code;           // exit code of error (1 lexical, 2 syntax, 3-10 semantic, 99 internal), 0 if none
+    char message[DIAG_MESSAGE_SIZE];
+} diag_t;
+
+// Record error with printf-like message and stop compilation
+_Noreturn void diag_raise(diag_t *diag, int code, const char *format, ...);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,144 @@
+/*
+* Project: Implementacia prekladaca imperativneho jazyka IFJ2024
+*
+* @author: Jakub Hrdlicka <xhrdli18>
+*
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/uio.h>
+#include "emit.h"
+
+
+// Initialize emitter, buffer is allocated with first text
+void emit_init(emitter_t *emitter, int fd){
+    emitter->buffer = NULL;
+    emitter->length = 0;
+    emitter->capacity = 0;
+    emitter->fd = fd;
+    emitter->diag = NULL;
+}
+
+// Write all given parts into file, repeats after partial write
+void emit_writev(emitter_t *emitter, struct iovec *parts, int count){
+    while (count > 0){
+        ssize_t written = writev(emitter->fd, parts, count);
+        if (written < 0){
+            if (errno == EINTR){
+                continue;
+            }
+            diag_raise(emitter->diag, 99, "Failed to write output");
+        }
+        // skip written parts, the first unfinished one is shortened
+        while (count > 0 && (size_t)written >= parts->iov_len){
+            written -= parts->iov_len;
+            parts++;
+            count--;
+        }
+        if (count > 0){
+            parts->iov_base = (char *)parts->iov_base + written;
+            parts->iov_len -= written;
+        }
+    }
+}
+
+// Grow buffer kept in memory so that length more bytes fit
+void emit_grow(emitter_t *emitter, size_t length){
+    size_t capacity = emitter->capacity == 0 ? EMIT_BUFFER_SIZE : emitter->capacity;
+    while (capacity - emitter->length <= length){    // one more byte for NUL of emit_take
+        capacity *= 2;
+    }
+    char *buffer = (char *)realloc(emitter->buffer, capacity);
+    if (buffer == NULL){
+        diag_raise(emitter->diag, 99, "Error: Allocation failed");
+    }
+    emitter->buffer = buffer;
+    emitter->capacity = capacity;
+}
+
+// Append text that does not fit into buffer
+void emit_overflow(emitter_t *emitter, const char *text, size_t length){
+    if (emitter->fd < 0){
+        emit_grow(emitter, length);
+    }
+    else if (emitter->buffer == NULL){
+        emit_grow(emitter, 0);
+    }
+
+    // Buffer of file is written out, text longer than buffer goes out together with it in one writev
+    if (emitter->capacity - emitter->length < length){
+        struct iovec parts[2] = {
+            {emitter->buffer, emitter->length},
+            {(void *)text, length}
+        };
+        bool direct = length >= emitter->capacity;
+        emit_writev(emitter, parts, direct ? 2 : 1);
+        emitter->length = 0;
+        if (direct){
+            return;
+        }
+    }
+    memcpy(emitter->buffer + emitter->length, text, length);
+    emitter->length += length;
+}
+
+// Append integer, digits are written from the end of local buffer
+void emit_int(emitter_t *emitter, int64_t value){
+    char digits[24];
+    char *end = digits + sizeof(digits);
+    char *start = end;
+    // negative numbers are converted digit by digit, so INT64_MIN does not overflow
+    uint64_t magnitude = value < 0 ? -(uint64_t)value : (uint64_t)value;
+    do {
+        *--start = '0' + magnitude % 10;
+        magnitude /= 10;
+    } while (magnitude != 0);
+    if (value < 0){
+        *--start = '-';
+    }
+    emit_text(emitter, start, end - start);
+}
+
+// Append float, exact hexadecimal form is left to snprintf (floats are rare)
+void emit_float(emitter_t *emitter, double value){
+    char text[64];
+    int length = snprintf(text, sizeof(text), "%a", value);
+    emit_text(emitter, text, length);
+}
+
+// Write out rest of buffer, output in memory is terminated by NUL
+void emit_flush(emitter_t *emitter){
+    if (emitter->fd < 0){
+        if (emitter->capacity - emitter->length < 1){
+            emit_grow(emitter, 0);
+        }
+        emitter->buffer[emitter->length] = '\0';
+    }
+    else if (emitter->length > 0){
+        struct iovec part = {emitter->buffer, emitter->length};
+        emit_writev(emitter, &part, 1);
+        emitter->length = 0;
+    }
+}
+
+// Take output kept in memory
+char *emit_take(emitter_t *emitter, size_t *length){
+    char *data = emitter->buffer;
+    *length = emitter->length;
+    emitter->buffer = NULL;
+    emitter->length = 0;
+    emitter->capacity = 0;
+    return data;
+}
+
+// Release buffer
+void emit_free(emitter_t *emitter){
+    free(emitter->buffer);
+    emitter->buffer = NULL;
+    emitter->length = 0;
+    emitter->capacity = 0;
+}
\ No newline at end of file
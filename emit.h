@@ -0,0 +1,69 @@
+/*
+* Project: Implementacia prekladaca imperativneho jazyka IFJ2024
+*
+* @author: Jakub Hrdlicka <xhrdli18>
+*
+*/
+
+#ifndef EMIT_H
+#define EMIT_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "diag.h"
+
+// Size of output buffer when writing into file
+#define EMIT_BUFFER_SIZE (64 * 1024)
+
+// Output of generated code, text is collected in one buffer
+// With file descriptor the buffer is written out whenever it is full,
+// without it the buffer grows and keeps whole output in memory
+typedef struct emitter {
+    char *buffer;
+    size_t length;
+    size_t capacity;
+    int fd;             // output file, -1 for output in memory
+    diag_t *diag;       // allocation and write failures are reported here
+} emitter_t;
+
+// Initialize emitter writing into fd, or into memory when fd is -1
+void emit_init(emitter_t *emitter, int fd);
+
+// Append text that does not fit into free space of buffer
+void emit_overflow(emitter_t *emitter, const char *text, size_t length);
+
+// Append text of given length
+static inline void emit_text(emitter_t *emitter, const char *text, size_t length){
+    if (emitter->capacity - emitter->length < length){
+        emit_overflow(emitter, text, length);
+        return;
+    }
+    memcpy(emitter->buffer + emitter->length, text, length);
+    emitter->length += length;
+}
+
+// Append string literal, its length is known at compile time
+#define emit_literal(emitter, text) emit_text((emitter), (text), sizeof(text) - 1)
+
+// Append NUL terminated string
+static inline void emit_str(emitter_t *emitter, const char *text){
+    emit_text(emitter, text, strlen(text));
+}
+
+// Append integer in decimal
+void emit_int(emitter_t *emitter, int64_t value);
+
+// Append float in hexadecimal notation of IFJcode24 (as %a of printf)
+void emit_float(emitter_t *emitter, double value);
+
+// Write out rest of the buffer, output in memory is only terminated by NUL
+void emit_flush(emitter_t *emitter);
+
+// Take output kept in memory after emit_flush, it has to be freed by caller
+char *emit_take(emitter_t *emitter, size_t *length);
+
+// Release buffer
+void emit_free(emitter_t *emitter);
+
+#endif
\ No newline at end of file
@@ -5,264 +5,187 @@
 *
 */
 #include <stdlib.h> 
-#include <string.h>
 #include <stdio.h>
 #include <stdbool.h>
 #include "lexer.h"
 #include "token.h"
-#include "string_stack.h"
-#include "bts_stack.h"
-#include "btree.h"
+#include "prec_stack.h"
 #include "expression.h"
 #include "ast.h"
-
-void create_postfix(bst_node_t *node, AST *ast);
-
-
-//append to binary tree and push to stack
-void bts_append(bts_Stack *stack, char* operation) {
-    //get nodes from stack
-    bst_node_t *right_child = bts_Stack_Top(stack); 
-    bts_Stack_Pop(stack); 
-    bst_node_t *left_child = bts_Stack_Top(stack);
-    bts_Stack_Pop(stack); 
-
-    //token representing operation
-    token_t *token = (token_t *)malloc(sizeof(token_t));
-    if (token == NULL) {
-        fprintf(stderr, "Error: malloc failed for token\n");
-        exit(99);
+#include "arena.h"
+
+//rules recognition, handle between stop sign and top of the stack is reduced to E
+//operands and operators are appended to expression as they are reduced, which gives postfix order
+void process_rule(prec_Stack *stack, lexer_t *lexer, AST *ast) {
+    int stop_idx = prec_Stack_Find_Stop(stack);
+    unsigned char *handle = &stack->symbol[stop_idx + 1];
+    token_t **handle_token = &stack->token[stop_idx + 1];
+    int length = stack->topIndex - stop_idx;
+
+    // E -> i
+    if (length == 1 && handle[0] == prec_operand) {
+        ast_postfix_push(ast, handle_token[0]);
     }
-    token->data = strdup(operation);
-    if (token->data == NULL) {
-        fprintf(stderr, "Error: strdup failed\n");
-        free(token);
-        exit(1);
+    // E -> E op E
+    else if (length == 3 && handle[0] == prec_expression && handle[1] <= prec_greater_equal && handle[2] == prec_expression) {
+        ast_postfix_push(ast, handle_token[1]);
     }
-    if(strcmp(token->data, "==") == 0){
-        token->type = double_equal_token;
-    } else if(strcmp(token->data, "!=") == 0){
-        token->type = not_equal_token;
-    } else {
-    token->type = binary_operator_token;
+    // E -> (E)
+    else if (length == 3 && handle[0] == prec_left_paren && handle[1] == prec_expression && handle[2] == prec_right_paren) {
+    }
+    else {
+        diag_raise(lexer->diag, 2, "Syntax error ");
     }
 
-    //creating new node
-    bst_node_t *node = bts_create_node(token);
-    node->left = left_child;
-    node->right = right_child;
-
-    //push new node to stack
-    bts_Stack_Push(stack, node); 
+    stack->topIndex = stop_idx - 1;
+    prec_Stack_Push(stack, prec_expression, NULL);
 }
 
-//rules recognition
-void process_rule(const char *rule, bts_Stack *stack) {
-    if (strcmp(rule, "E+E") == 0) {
-        bts_append(stack,  "+");
-    } 
-    else if (strcmp(rule, "E-E") == 0) {
-        bts_append(stack,  "-");
-    } 
-    else if (strcmp(rule, "E*E") == 0) {
-        bts_append(stack,  "*");
-    } 
-    else if (strcmp(rule, "E/E") == 0) {
-        bts_append(stack,  "/");
-    } 
-    else if (strcmp(rule, "(E)") == 0) {
-    } 
-    else if (strcmp(rule, "i") == 0) {
-    } 
-    else if (strcmp(rule, "E==E") == 0) {
-        bts_append(stack,  "==");
-    } 
-    else if (strcmp(rule, "E!=E") == 0) {
-        bts_append(stack,  "!=");
-    } 
-    else if (strcmp(rule, "E<E") == 0) {
-        bts_append(stack,  "<");
-    } 
-    else if (strcmp(rule, "E>E") == 0) {
-        bts_append(stack,  ">");
-    } 
-    else if (strcmp(rule, "E<=E") == 0) {
-        bts_append(stack,  "<=");
-    } 
-    else if (strcmp(rule, "E>=E") == 0) {
-        bts_append(stack,  ">=");
-    } else {
-        fprintf(stderr, "Syntax error \n");
-        exit(2);
+//symbol of input token
+prec_symbol_t input_symbol(token_t *token, lexer_t *lexer){
+    if(token->type == identifier_token || token->type == int_token || token->type == float_token || token->type == string_token || token->type == null_token) {
+        return prec_operand;
+    }
+    switch (token->kind) {
+        case kind_multiply:         return prec_multiply;
+        case kind_divide:           return prec_divide;
+        case kind_plus:             return prec_plus;
+        case kind_minus:            return prec_minus;
+        case kind_equal:            return prec_equal;
+        case kind_not_equal:        return prec_not_equal;
+        case kind_less:             return prec_less;
+        case kind_greater:          return prec_greater;
+        case kind_less_equal:       return prec_less_equal;
+        case kind_greater_equal:    return prec_greater_equal;
+        case kind_left_paren:       return prec_left_paren;
+        case kind_right_paren:      return prec_right_paren;
+        case kind_semicolon:        return prec_end;
+        default:
+            diag_raise(lexer->diag, 2, "Syntax error ");
     }
 }
 
-//check input token
-token_t* check_token(token_t* token, int* brackets, token_t* output_token){
-    if(*brackets != -1){
-        token = get_token();
-        if (strcmp(token->data,"(") == 0){
-            (*brackets)++;
-        }
-        else if (strcmp(token->data,")") == 0){
-            (*brackets)--;
-        }
+//check input token, end of expression is ';' or ')' without pair
+token_t* check_token(token_t* token, lexer_t *lexer, int* brackets, token_t* output_token, bool* end){
+    token = get_token(lexer);
+    if (token->kind == kind_left_paren){
+        (*brackets)++;
+    }
+    else if (token->kind == kind_right_paren){
+        (*brackets)--;
     }
             
-    if(strcmp(token->data, ";") == 0 || *brackets == -1){
-        output_token->data = token->data;
-        output_token->type = token->type;
-        token->data = "$";
+    if(token->kind == kind_semicolon || *brackets == -1){
+        *output_token = *token;
+        *end = true;
     }
 
     return token;
 }
 
-//precedence table
-const char *precedence_table[15][15] = {
-    {"",     "*",   "/",   "+",   "-",  "==",  "!=",   "<",   ">",   "<=",  ">=",  "(",   ")",   "i", "$"},
-    { "*",   "R",   "R",   "R",   "R",   "R",   "R",   "R",   "R",   "R",   "R",   "S",   "R",   "S", "R"},
-    { "/",   "R",   "R",   "R",   "R",   "R",   "R",   "R",   "R",   "R",   "R",   "S",   "R",   "S", "R"},
-    { "+",   "S",   "S",   "R",   "R",   "R",   "R",   "R",   "R",   "R",   "R",   "S",   "R",   "S", "R"},
-    { "-",   "S",   "S",   "R",   "R",   "R",   "R",   "R",   "R",   "R",   "R",   "S",   "R",   "S", "R"},
-    { "==",  "S",   "S",   "S",   "S",   "R",   "R",   "S",   "S",   "S",   "S",   "S",   "R",   "S", "R"},
-    { "!=",  "S",   "S",   "S",   "S",   "R",   "R",   "S",   "S",   "S",   "S",   "S",   "R",   "S", "R"},
-    { "<",   "S",   "S",   "S",   "S",   "S",   "S",   "R",   "R",   "R",   "R",   "S",   "R",   "S", "R"},
-    { ">",   "S",   "S",   "S",   "S",   "S",   "S",   "R",   "R",   "R",   "R",   "S",   "R",   "S", "R"},
-    { "<=",  "S",   "S",   "S",   "S",   "S",   "S",   "R",   "R",   "R",   "R",   "S",   "R",   "S", "R"},
-    { ">=",  "S",   "S",   "S",   "S",   "S",   "S",   "R",   "R",   "R",   "R",   "S",   "R",   "S", "R"},
-    { "(",   "S",   "S",   "S",   "S",   "S",   "S",   "S",   "S",   "S",   "S",   "S",   "=",   "S", " "},
-    { ")",   "R",   "R",   "R",   "R",   "R",   "R",   "R",   "R",   "R",   "R",   "E",   "R",   "E", "R"},
-    { "i",   "R",   "R",   "R",   "R",   "R",   "R",   "R",   "R",   "R",   "R",   "O",   "R",   "E", "R"},
-    { "$",   "S",   "S",   "S",   "S",   "S",   "S",   "S",   "S",   "S",   "S",   "S",   "E",   "S", " "}
-        
+//actions of precedence table
+typedef enum prec_action {
+    S,  //shift
+    R,  //reduce
+    Q,  //shift ')' and reduce (E)
+    O,  //function call, expression ends
+    E   //error
+} prec_action_t;
+
+//precedence table, row is topmost terminal in stack, column is input
+const prec_action_t precedence_table[PREC_TERMINALS][PREC_TERMINALS] = {
+    //        *  /  +  -  == != <  >  <= >= (  )  i  $
+    /* *  */ {R, R, R, R, R, R, R, R, R, R, S, R, S, R},
+    /* /  */ {R, R, R, R, R, R, R, R, R, R, S, R, S, R},
+    /* +  */ {S, S, R, R, R, R, R, R, R, R, S, R, S, R},
+    /* -  */ {S, S, R, R, R, R, R, R, R, R, S, R, S, R},
+    /* == */ {S, S, S, S, R, R, S, S, S, S, S, R, S, R},
+    /* != */ {S, S, S, S, R, R, S, S, S, S, S, R, S, R},
+    /* <  */ {S, S, S, S, S, S, R, R, R, R, S, R, S, R},
+    /* >  */ {S, S, S, S, S, S, R, R, R, R, S, R, S, R},
+    /* <= */ {S, S, S, S, S, S, R, R, R, R, S, R, S, R},
+    /* >= */ {S, S, S, S, S, S, R, R, R, R, S, R, S, R},
+    /* (  */ {S, S, S, S, S, S, S, S, S, S, S, Q, S, E},
+    /* )  */ {R, R, R, R, R, R, R, R, R, R, E, R, E, R},
+    /* i  */ {R, R, R, R, R, R, R, R, R, R, O, R, E, R},
+    /* $  */ {S, S, S, S, S, S, S, S, S, S, S, E, S, E}
 };
 
-//process expression
-token_t* expression(token_t *token, AST *ast){
+//process expression, node of expression is returned in node
+token_t* expression(token_t *token, lexer_t *lexer, AST *ast, ast_index_t *node){
 
     //initializing 
     int brackets = 0;
+    bool end = false;
 
-    if (strcmp(token->data,"(") == 0){
+    if (token->kind == kind_left_paren){
         brackets++;
     }
-    else if (strcmp(token->data,")") == 0){
+    else if (token->kind == kind_right_paren){
         brackets--;
     }
 
-    Stack stack;
-    Stack_Init(&stack);
-    Stack_Push(&stack, "$");
-
-    bts_Stack bts_stack;
-    bts_Stack_Init(&bts_stack);
+    prec_Stack stack;
+    prec_Stack_Init(&stack, lexer->arena);
+    prec_Stack_Push(&stack, prec_end, NULL);
 
     token_t *output_token;
-    output_token = malloc(sizeof(token_t));
-
+    output_token = arena_alloc(lexer->arena, sizeof(token_t));
 
-    while (true) {
-        //getting column number in precedence table
-        int row;
-        int column;
-        bool correct_input = false;
-        if(token->type == identifier_token || token->type == int_token || token->type == float_token || token->type == string_token || token->type == null_token) {
-            column = 13;
-            correct_input = true;
-        }
-        else{
-            for (int i = 0; i < 15; i++) {
-                if (strcmp(token->data, precedence_table[0][i]) == 0) {
-                    column = i;
-                    correct_input = true;
-                }
-            }
-        }
-
-        //input check
-        if(correct_input == false && strcmp(token->data, ";") != 0){
-            fprintf(stderr, "Syntax error \n");
-            exit(2);
-        }
-        
-        //getting row number in precedence table
-        char *topToken = stack.string[Stack_find(&stack)];
-            for (int i = 0; i < 15; i++) {
-                if (strcmp(topToken, precedence_table[0][i]) == 0) {
-                row = i;
-                }
-            }
+    bool call = false;
+    while (!call) {
+        //row and column in precedence table
+        prec_symbol_t input = end ? prec_end : input_symbol(token, lexer);
+        prec_symbol_t top = prec_Stack_Top_Terminal(&stack);
 
         //expression processed 
-        if (strcmp(topToken, "$") == 0 && strcmp(token->data, "$") == 0){
+        if (top == prec_end && input == prec_end){
             break;
         }
 
-        //shift
-        if(strcmp(precedence_table[row][column], "S") == 0){
-            if(token->type == identifier_token || token->type == int_token || token->type == float_token || token->type == string_token || token->type == null_token) {
-            Stack_insert_str(&stack);
-                Stack_Push(&stack, "i");
-                bst_node_t *node = bts_create_node(token);
-                bts_Stack_Push(&bts_stack, node);
-            }
-            else {
-                Stack_insert_str(&stack);
-                Stack_Push(&stack, token->data);
-            }
-
-            token = check_token(token, &brackets, output_token);
-        }
-
-        //reduce
-        else if (strcmp(precedence_table[row][column], "R") == 0) {
-            char *rule = Stack_rule_str(&stack);
-            process_rule(rule, &bts_stack);
-            Stack_extract_str(&stack);
-            Stack_Push(&stack, "E");
-        }
-
-        //equal operation
-        else if (strcmp(precedence_table[row][column], "=") == 0) {
-            Stack_Push(&stack, token->data);
-            char *rule = Stack_rule_str(&stack);
-            process_rule(rule, &bts_stack);
-            Stack_extract_str(&stack);
-            Stack_Push(&stack, "E");
-
-            token = check_token(token, &brackets, output_token);
-        }
-
-        else if (strcmp(precedence_table[row][column], "O") == 0) {
-            output_token->data = token->data;
-            output_token->type = token->type;
-            break;
-        }
+        switch (precedence_table[top][input]) {
+            //shift
+            case S:
+                prec_Stack_Insert_Stop(&stack);
+                prec_Stack_Push(&stack, input, token);
+                token = check_token(token, lexer, &brackets, output_token, &end);
+                break;
+
+            //reduce
+            case R:
+                process_rule(&stack, lexer, ast);
+                break;
+
+            //equal operation
+            case Q:
+                prec_Stack_Push(&stack, input, token);
+                process_rule(&stack, lexer, ast);
+                token = check_token(token, lexer, &brackets, output_token, &end);
+                break;
+
+            //function call, it has to be the whole expression ($ [ i)
+            case O:
+                if (stack.topIndex != 2) {
+                    diag_raise(lexer->diag, 2, "Syntax error ");
+                }
+                ast_postfix_push(ast, stack.token[2]);
+                *output_token = *token;
+                call = true;
+                break;
 
-        else if (strcmp(precedence_table[row][column], "E") == 0) {
-            fprintf(stderr, "Syntax error \n");
-            exit(2);
+            default:
+                diag_raise(lexer->diag, 2, "Syntax error ");
         }
+    }
 
+    //empty expression, nothing was reduced
+    if (!call && stack.topIndex != 1){
+        diag_raise(lexer->diag, 2, "Syntax error ");
     }
     
-    //add to AST
-    bst_node_t *parent = bts_Stack_Top(&bts_stack); 
-    bts_Stack_Pop(&bts_stack);
-    create_postfix(parent, ast);
-    
+    *node = create_expression_node(ast);
+
     //dispose all
-    Stack_Dispose(&stack);
-    bts_Stack_Dispose(&bts_stack);
+    prec_Stack_Dispose(&stack);
     return output_token;
 }
-
-//create postfix from btree
-void create_postfix(bst_node_t *node, AST *ast){
-    if (node != NULL){
-        create_postfix(node->left, ast);
-        create_postfix(node->right, ast);
-        create_node(node->value, ast);
-    }
-}
@@ -9,8 +9,9 @@
 
 #include "token.h"
 #include "ast.h"
+#include "lexer.h"
 
-//process expression 
-token_t* expression(token_t *token, AST *ast);
+//process expression, node of expression is returned in node
+token_t* expression(token_t *token, lexer_t *lexer, AST *ast, ast_index_t *node);
 
 #endif
\ No newline at end of file
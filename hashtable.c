@@ -10,131 +10,142 @@
 #include <string.h>
 #include <stdbool.h>
 #include "hashtable.h"
+#include "arena.h"
 
 
-void ht_resize(ht_table_t *table);
+// Hash function, ids of interned names are unique numbers (their text is hashed with FNV-1a in intern.c)
+// Fibonacci hashing spreads them over the table using the upper bits of the product
+uint32_t get_hash(int id, int shift) {
+  return ((uint32_t)id * 2654435769u) >> shift;
+}
 
+// Allocate empty slots, size is power of two
+void ht_alloc_slots(ht_table_t *table, int size) {
+  // Table keeps its old slots when allocation fails
+  ht_slot_t *slots = (ht_slot_t *)malloc(size * sizeof(ht_slot_t));
+  if (slots == NULL){
+    diag_raise(table->arena->diag, 99, "Error: malloc failed");
+  }
+  table->slots = slots;
+  for (int i = 0; i < size; i++){
+    table->slots[i].id = HT_EMPTY;
+    table->slots[i].item = NULL;
+  }
 
-// Hash function
-int get_hash(char *key, int table_size) {
-  int result = 1;
-  int length = strlen(key);
-  for (int i = 0; i < length; i++) {
-    result += key[i];
+  table->size = size;
+  table->shift = 32;
+  while (size > 1){
+    table->shift--;
+    size /= 2;
   }
-  return (result % table_size);
 }
 
 // Initialize table
-void ht_init(ht_table_t *table, int table_size) {
-  table->items = (ht_item_t **)malloc(table_size * sizeof(ht_item_t *));
-  if(table->items == NULL){
-    fprintf(stderr, "Error: Allocation failed\n");
-    exit(99);
+void ht_init(ht_table_t *table, int table_size, arena_t *arena) {
+  int size = 16;
+  while (size < table_size){
+    size *= 2;
   }
-
-  table->size = table_size;
+  table->slots = NULL;
   table->item_count = 0;
+  table->arena = arena;
+  ht_alloc_slots(table, size);
+}
 
-  for (int i = 0; i < table_size; i++){
-    table->items[i] = NULL;
+// Index of slot with item of given id, or of empty slot where it belongs
+int ht_find_slot(ht_table_t *table, int id) {
+  int mask = table->size - 1;
+  int i = get_hash(id, table->shift);
+  while (table->slots[i].id != HT_EMPTY && table->slots[i].id != id){
+    i = (i + 1) & mask;
   }
+  return i;
 }
 
 // Search for item in table
-ht_item_t *ht_search(ht_table_t *table, char *name) {
-  int hash = get_hash(name, table->size);
-  ht_item_t *item = table->items[hash];
+ht_item_t *ht_search(ht_table_t *table, int id) {
+  // not an identifier
+  if (id < 0){
+    return NULL;
+  }
+  return table->slots[ht_find_slot(table, id)].item;
+}
+
+// Double number of slots and move items into them
+void ht_resize(ht_table_t *table){
+  ht_slot_t *old_slots = table->slots;
+  int old_size = table->size;
 
-  while (item != NULL){
-    if (strcmp(item->name, name) == 0){
-      return item;
+  ht_alloc_slots(table, old_size * 2);
+  for (int i = 0; i < old_size; i++){
+    if (old_slots[i].id != HT_EMPTY){
+      table->slots[ht_find_slot(table, old_slots[i].id)] = old_slots[i];
     }
-    item = item->next;
   }
-  return NULL;
+  free(old_slots);
 }
 
 // Insert new item into table
-void ht_insert(ht_table_t *table, ht_item_t *item) {
-    // Resize table if needed
-    if (table->item_count >= table->size){
-        ht_resize(table);
-    }
+ht_item_t *ht_insert(ht_table_t *table, ht_item_t *item) {
+  // Keep load factor under 1/2
+  if ((table->item_count + 1) * 2 > table->size){
+    ht_resize(table);
+  }
 
   // Existing item
-  ht_item_t *existing_item = ht_search(table, item->name);
-  if (existing_item != NULL){
-    fprintf(stderr, "Redefinition of function %s\n", item->name);
-    exit(5);
+  int i = ht_find_slot(table, item->id);
+  if (table->slots[i].id != HT_EMPTY){
+    diag_raise(table->arena->diag, 5, "Redefinition of %s %s", item->type == sym_func_type ? "function" : "variable", item->name);
   }
 
-  // New item
-  ht_item_t *new_item = (ht_item_t *)malloc(sizeof(struct ht_item));
-  if (new_item == NULL){
-    fprintf(stderr, "Error: Allocation failed\n");
-    exit(99);
-  }
-  new_item->name = item->name;
-  new_item->type = item->type;
-  new_item->var_type = item->var_type;
-  new_item->input_parameters = item->input_parameters;
-  new_item->used = item->used;
-  new_item->modified = item->modified;
-  new_item->return_type = item->return_type;
-  new_item->params = item->params;
+  // New item, items do not move when table is resized
+  ht_item_t *new_item = (ht_item_t *)arena_alloc(table->arena, sizeof(struct ht_item));
+  *new_item = *item;
 
-  int hash = get_hash(item->name, table->size);
-  
-  // Add new value into the list
-  if (table->items[hash] != NULL){
-    new_item->next = table->items[hash];
-    table->items[hash] = new_item;
-    return;
-  }
-
-  // Add new value at the beginning
-  new_item->next = NULL;
-  table->items[hash] = new_item;
+  table->slots[i].id = item->id;
+  table->slots[i].item = new_item;
   table->item_count++;
+  return new_item;
 }
 
 
 // Delete item from table
-void ht_delete(ht_table_t *table, char *name) {
-  int hash = get_hash(name, table->size);
-  ht_item_t *item = table->items[hash];
-  if (item == NULL){
+void ht_delete(ht_table_t *table, int id) {
+  int mask = table->size - 1;
+  int i = ht_find_slot(table, id);
+  if (table->slots[i].id == HT_EMPTY){
     return;
   }
-
-  if (item->name == name){
-    if (item->next != NULL){
-      table->items[hash] = item->next;
-      free(item);
-      item = NULL;
-      return;
+  table->item_count--;
+
+  // Items after the hole that would not be found anymore are shifted back into it
+  // Item is only unlinked, its memory is released with the arena
+  int j = i;
+  while (true){
+    j = (j + 1) & mask;
+    if (table->slots[j].id == HT_EMPTY){
+      break;
+    }
+    int home = get_hash(table->slots[j].id, table->shift);
+    // home is cyclically outside of (i, j], the item can move to i
+    if ((i <= j) ? (home <= i || home > j) : (home <= i && home > j)){
+      table->slots[i] = table->slots[j];
+      i = j;
     }
-    table->items[hash] = NULL;
-    free(item);
-    item = NULL;
-    return;
   }
+  table->slots[i].id = HT_EMPTY;
+  table->slots[i].item = NULL;
+}
 
-  while (item->next != NULL){
-    if (item->next->name == name){
-      if (item->next->next != NULL){
-        ht_item_t *temp = item->next;
-        item->next = temp->next;
-        free(temp);
-        temp = NULL;
-        return;
-      }
-      free(item->next);
-      item->next = NULL;
-      return;
-    }
-    item = item->next;
+
+// Check if item was used and variable was modified
+void ht_check_usage(ht_table_t *table, ht_item_t *item) {
+  if((item->type != sym_func_type) && (item->used == false)){
+      diag_raise(table->arena->diag, 9, "Semantic error 9: Unused variable: %s", item->name);
+  }
+  // Added modified check
+  if((item->var_type == sym_var) && (item->modified == false)){
+      diag_raise(table->arena->diag, 9, "Semantic error 9: Variable declared but not modified %s", item->name);
   }
 }
 
@@ -142,165 +153,30 @@ void ht_delete(ht_table_t *table, char *name) {
 // Delete all items from table
 void ht_delete_all(ht_table_t *table) {
   for (int i = 0; i < table->size; i++){
-    while (table->items[i] != NULL){
-      ht_item_t *item = table->items[i];
-      if((item->type != sym_func_type) && (item->used == false)){
-          fprintf(stderr, "Semantic error 9: Unused variable: %s\n", item->name);
-          exit(9);
-      }
-      // Added modified check
-      if((item->var_type == sym_var) && (item->modified == false)){
-          fprintf(stderr, "Semantic error 9: Variable declared but not modified %s\n", item->name);
-          exit(9);
-      }
-      ht_item_t *temp = item;
-      item = item->next;
-      table->items[i] = item;
-      free(temp->params);
-      free(temp);
-      temp = NULL;
-      continue;
-      }
-      table->items[i] = NULL;
-    }
-    table = NULL;
-}
-
-
-// Check if number is prime
-int is_prime(int number){
-    if (number <= 1){
-        return 0;
+    if (table->slots[i].id != HT_EMPTY){
+      ht_check_usage(table, table->slots[i].item);
     }
-    if (number == 2){
-        return 1;
-    }
-    if (number % 2 == 0){
-        return 0;
-    }
-
-    for (int i = 3; i * i <= number; i += 2){
-        if (number % i == 0){
-            return 0;
-        }
-    }
-    return 1;
-}
-
-
-// Find next prime number
-int next_prime(int number){
-    while(is_prime(number) == 0){
-        number++;
-    }
-    return number;
-}
-
-
-// Resize table
-void ht_resize(ht_table_t *table){
-    // Create new table
-    int new_size = next_prime(table->size * 2);
-    ht_table_t new_table;
-    new_table.size = new_size;
-    new_table.item_count = 0;
-    new_table.items = (ht_item_t **)malloc(new_size * sizeof(ht_item_t *));
-
-    if (new_table.items == NULL){
-        fprintf(stderr, "Error: Allocation failed\n");
-        exit(99);
-    }
-
-    for(int i = 0; i < new_size; i++){
-        new_table.items[i] = NULL;
-    }
-
-    // Copy items from old table to new table
-    for(int i = 0; i < table->size; i++){
-        ht_item_t *item = table->items[i];
-        while(item != NULL){
-            ht_insert(&new_table, item);
-            item = item->next;
-        }
-    }
-
-    // Delete old table
-    ht_delete_all(table);
-    free(table->items);
-
-    // Set new table
-    table->items = new_table.items;
-    table->size = new_size;
-    table->item_count = new_table.item_count;
-}
-
-
-// Copy table item
-ht_item_t *ht_copy_item(ht_item_t *item){
-  if(item == NULL){
-    return NULL;
   }
-
-  ht_item_t *new_item = (ht_item_t *)malloc(sizeof(struct ht_item));
-  if (new_item == NULL){
-    fprintf(stderr, "Error: Allocation failed\n");
-    exit(99);
-  }
-
-  new_item->name = strdup(item->name);
-  if(new_item->name == NULL){
-    free(new_item);
-    fprintf(stderr, "Error: Allocation failed\n");
-    exit(99);
-  }
-
-  new_item->type = item->type;
-  new_item->var_type = item->var_type;
-  new_item->used = item->used;
-  new_item->modified = item->modified;
-  new_item->input_parameters = item->input_parameters;
-  new_item->params = item->params;
-  new_item->return_type = item->return_type;
-  
-
-  new_item->next = ht_copy_item(item->next);
-
-  return new_item;
+  ht_free(table);
 }
 
-
-// Copy table
-void ht_copy(ht_table_t *old_table, ht_table_t *new_table){
-  new_table->size = old_table->size;
-  new_table->item_count = old_table->item_count;
-  new_table->items = (ht_item_t **)malloc(new_table->size * sizeof(ht_item_t *));
-  if(new_table->items == NULL){
-    fprintf(stderr, "Error: Allocation failed\n");
-    exit(99);
-  }
-
-  for(int i = 0; i < new_table->size; i++){
-    if(old_table->items[i] != NULL){
-      new_table->items[i] = ht_copy_item(old_table->items[i]);
-    }
-    else{
-      new_table->items[i] = NULL;
-    }
-  }
+// Free slots of table without any checks
+void ht_free(ht_table_t *table) {
+  free(table->slots);
+  table->slots = NULL;
+  table->size = 0;
+  table->item_count = 0;
 }
 
 // Function to print the contents of the hashtable
 void ht_print(ht_table_t *table){
     fprintf(stderr, "Hashtable Contents:\n");
     for(int i = 0; i < table->size; i++){
-        ht_item_t *item = table->items[i];
+        ht_item_t *item = table->slots[i].item;
         if(item != NULL){
-            fprintf(stderr, "Bucket %d:\n", i);
-            while(item != NULL){
-                fprintf(stderr, "  Name: %s, Type: %d, Var Type: %d, Used: %d, Modified: %d, Input Params: %d, Return Type: %d\n",
-                       item->name, item->type, item->var_type, item->used, item->modified, item->input_parameters, item->return_type);
-                item = item->next;
-            }
+            fprintf(stderr, "Slot %d:\n", i);
+            fprintf(stderr, "  Name: %s, Type: %d, Var Type: %d, Used: %d, Modified: %d, Input Params: %d, Return Type: %d\n",
+                   item->name, item->type, item->var_type, item->used, item->modified, item->input_parameters, item->return_type);
         }
     }
 }
\ No newline at end of file
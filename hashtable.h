@@ -9,6 +9,8 @@
 #define HASHTABLE_H
 
 #include <stdbool.h>
+#include <stdint.h>
+#include "arena.h"
 
 // For types of variables and other helpful types (changing order might break something, do with caution)
 typedef enum symtable_type{
@@ -35,45 +37,61 @@ typedef enum symtable_var_type{
 
 // Item in symtable
 typedef struct ht_item {
+  int id;       // interned id of name, items are hashed and compared by it
   char *name;
   symtable_type_t type;
   symtable_var_type_t var_type;
   bool used;
   bool modified;
   int input_parameters;
-  symtable_type_t *params;
+  const symtable_type_t *params;
   symtable_type_t return_type;
-  struct ht_item *next;
 } ht_item_t;
 
-// Symtable itself
+// Id of empty slot
+#define HT_EMPTY -1
+
+// Slot of symtable, id is kept next to item so probing does not touch items
+typedef struct ht_slot {
+  int id;
+  ht_item_t *item;
+} ht_slot_t;
+
+// Symtable itself, open addressing with linear probing
 typedef struct ht_table {
-    ht_item_t **items;
-    int size;
+    ht_slot_t *slots;
+    int size;         // number of slots, power of two
+    int shift;        // 32 - log2(size), for hashing
     int item_count;
+    arena_t *arena;   // memory of items
 } ht_table_t;
 
 // Initialize table
-// Use only prime number for size, recommended size is 101
-void ht_init(ht_table_t *table, int table_size);
+// Size is rounded up to power of two, recommended size is 128
+// Items are allocated in given arena
+void ht_init(ht_table_t *table, int table_size, arena_t *arena);
 
 // Search for item in table
-ht_item_t *ht_search(ht_table_t *table, char *name);
+ht_item_t *ht_search(ht_table_t *table, int id);
 
-// Insert new item into table
+// Insert new item into table, returns the inserted item
 // Also checking redefinition sematic error
-void ht_insert(ht_table_t *table, ht_item_t *item);
-
-// Copy table into new one
-void ht_copy(ht_table_t *old_table, ht_table_t *new_table);
+ht_item_t *ht_insert(ht_table_t *table, ht_item_t *item);
 
 // Delete item from table
-void ht_delete(ht_table_t *table, char *name);
+void ht_delete(ht_table_t *table, int id);
 
-// Delete all items from table
+// Check if item was used and variable was modified
+// Raises unused variable semantic error
+void ht_check_usage(ht_table_t *table, ht_item_t *item);
+
+// Delete all items from table and free its slots
 // Also checking unused variable semantic error
 void ht_delete_all(ht_table_t *table);
 
+// Free slots of table without checks, for cleanup after error
+void ht_free(ht_table_t *table);
+
 // Prints out all items of symtable of current scope
 void ht_print(ht_table_t *table);
 
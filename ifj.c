@@ -0,0 +1,65 @@
+/*
+* Project: Implementacia prekladaca imperativneho jazyka IFJ2024
+*
+* @author: Jakub Hrdlicka <xhrdli18>
+*
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "ifj.h"
+#include "compiler.h"
+
+
+// Finish compilation, copy error into diag and release compiler
+int ifj_finish(compiler_t *compiler, int code, ifj_diag_t *diag){
+    diag->code = code;
+    diag->message[0] = '\0';
+    if (code != 0){
+        snprintf(diag->message, sizeof(diag->message), "%s", compiler->diag.message);
+    }
+    // Report of allocations, for checking memory use of compiler
+    else if (getenv("IFJ_ALLOC_REPORT") != NULL){
+        arena_report(&compiler->arena);
+    }
+
+    compiler_free(compiler);
+    return code;
+}
+
+// Compile source from memory into memory
+int ifj_compile(const char *src, size_t len, ifj_output_t *out, ifj_diag_t *diag){
+    emitter_t emitter;
+    emit_init(&emitter, -1);
+
+    compiler_t compiler;
+    int code = compiler_run(&compiler, src, len, &emitter);
+
+    out->data = NULL;
+    out->length = 0;
+    if (code == 0){
+        out->data = emit_take(&emitter, &out->length);
+    }
+    emit_free(&emitter);
+
+    return ifj_finish(&compiler, code, diag);
+}
+
+// Compile source from memory into file
+int ifj_compile_fd(const char *src, size_t len, int fd, ifj_diag_t *diag){
+    emitter_t emitter;
+    emit_init(&emitter, fd);
+
+    compiler_t compiler;
+    int code = compiler_run(&compiler, src, len, &emitter);
+    emit_free(&emitter);
+
+    return ifj_finish(&compiler, code, diag);
+}
+
+// Release generated code
+void ifj_output_free(ifj_output_t *out){
+    free(out->data);
+    out->data = NULL;
+    out->length = 0;
+}
\ No newline at end of file
@@ -0,0 +1,39 @@
+/*
+* Project: Implementacia prekladaca imperativneho jazyka IFJ2024
+*
+* @author: Jakub Hrdlicka <xhrdli18>
+*
+*/
+
+#ifndef IFJ_H
+#define IFJ_H
+
+#include <stddef.h>
+
+// Public interface of compiler library (libifj.a)
+// Compilations share no state, so they can run one after another or in parallel threads
+
+// Generated IFJcode24, data is NUL terminated and released by ifj_output_free
+typedef struct ifj_output {
+    char *data;
+    size_t length;
+} ifj_output_t;
+
+// Error of compilation
+typedef struct ifj_diag {
+    int code;           // same as exit code of compiler, 0 if there is no error
+    char message[256];
+} ifj_diag_t;
+
+// Compile source of given length, it does not have to be NUL terminated
+// Returns 0 and fills out, or returns exit code of the error and fills diag (out is then empty)
+int ifj_compile(const char *src, size_t len, ifj_output_t *out, ifj_diag_t *diag);
+
+// Compile source of given length and write generated code into file descriptor
+// Output is written in large blocks while it is generated, returns 0 or exit code of the error
+int ifj_compile_fd(const char *src, size_t len, int fd, ifj_diag_t *diag);
+
+// Release generated code
+void ifj_output_free(ifj_output_t *out);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,123 @@
+/*
+* Project: Implementacia prekladaca imperativneho jazyka IFJ2024
+*
+* @author: Jakub Hrdlicka <xhrdli18>
+*
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "intern.h"
+#include "arena.h"
+#include "builtins.h"
+
+// Initial number of slots, always power of two
+#define INTERN_INIT_SLOTS 256
+
+// FNV-1a hash of identifier
+uint32_t intern_hash(const char *data, size_t length){
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < length; i++){
+        hash ^= (unsigned char)data[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+// Allocate empty slots
+void intern_alloc_slots(intern_table_t *table, int count){
+    table->slots = (int *)calloc(count, sizeof(int));
+    if (table->slots == NULL){
+        diag_raise(table->arena->diag, 99, "Error: Allocation failed");
+    }
+    table->slot_count = count;
+}
+
+// Double number of slots and rehash all entries
+void intern_grow(intern_table_t *table){
+    free(table->slots);
+    table->slots = NULL;
+    intern_alloc_slots(table, table->slot_count * 2);
+    for (int id = 0; id < table->count; id++){
+        uint32_t i = table->entries[id].hash & (table->slot_count - 1);
+        while (table->slots[i] != 0){
+            i = (i + 1) & (table->slot_count - 1);
+        }
+        table->slots[i] = id + 1;
+    }
+}
+
+// Initialize table with fixed ids
+void intern_init(intern_table_t *table, arena_t *arena){
+    table->entries = NULL;
+    table->count = 0;
+    table->capacity = 0;
+    table->arena = arena;
+    intern_alloc_slots(table, INTERN_INIT_SLOTS);
+
+    intern(table, "_", 1);     // gets INTERN_UNDERSCORE
+    // built-in functions get ids from INTERN_BUILTIN_FIRST
+    for (int id = INTERN_BUILTIN_FIRST; id < INTERN_BUILTIN_FIRST + BUILTIN_COUNT; id++){
+        intern_string(table, builtin_function(id)->name);
+    }
+}
+
+// Return unique id of identifier of given length
+int intern(intern_table_t *table, const char *data, size_t length){
+    uint32_t hash = intern_hash(data, length);
+    uint32_t i = hash & (table->slot_count - 1);
+    while (table->slots[i] != 0){
+        intern_entry_t *entry = &table->entries[table->slots[i] - 1];
+        if (entry->hash == hash && entry->length == length && memcmp(entry->text, data, length) == 0){
+            return table->slots[i] - 1;
+        }
+        i = (i + 1) & (table->slot_count - 1);
+    }
+
+    // New identifier
+    if (table->count == table->capacity){
+        int capacity = table->capacity == 0 ? INTERN_INIT_SLOTS : table->capacity * 2;
+        intern_entry_t *entries = (intern_entry_t *)realloc(table->entries, capacity * sizeof(intern_entry_t));
+        if (entries == NULL){
+            diag_raise(table->arena->diag, 99, "Error: Allocation failed");
+        }
+        table->entries = entries;
+        table->capacity = capacity;
+    }
+    char *text = arena_strndup(table->arena, data, length);
+
+    int id = table->count++;
+    table->entries[id].text = text;
+    table->entries[id].length = length;
+    table->entries[id].hash = hash;
+    table->slots[i] = id + 1;
+
+    // Keep load factor under 1/2
+    if (table->count * 2 > table->slot_count){
+        intern_grow(table);
+    }
+    return id;
+}
+
+// Return unique id of NUL terminated identifier
+int intern_string(intern_table_t *table, const char *text){
+    return intern(table, text, strlen(text));
+}
+
+// Canonical text of interned identifier
+char *intern_text(intern_table_t *table, int id){
+    return table->entries[id].text;
+}
+
+// Release all interned identifiers
+void intern_free(intern_table_t *table){
+    free(table->entries);
+    free(table->slots);
+    table->entries = NULL;
+    table->slots = NULL;
+    table->count = 0;
+    table->capacity = 0;
+    table->slot_count = 0;
+}
\ No newline at end of file
@@ -0,0 +1,53 @@
+/*
+* Project: Implementacia prekladaca imperativneho jazyka IFJ2024
+*
+* @author: Jakub Hrdlicka <xhrdli18>
+*
+*/
+
+#ifndef INTERN_H
+#define INTERN_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "arena.h"
+
+// Id of token that is not an identifier
+#define INTERN_NONE -1
+
+// Id of "_", interned first so it is known without lookup
+#define INTERN_UNDERSCORE 0
+
+// Interned identifier
+typedef struct intern_entry {
+    char *text;
+    size_t length;
+    uint32_t hash;
+} intern_entry_t;
+
+// Identifiers of one compilation
+typedef struct intern_table {
+    intern_entry_t *entries;    // indexed by id
+    int count;
+    int capacity;
+    int *slots;                 // open addressing, slots hold id + 1 (0 is empty slot)
+    int slot_count;
+    arena_t *arena;             // text of identifiers
+} intern_table_t;
+
+// Initialize table, "_" and names of built-in functions get their fixed ids
+void intern_init(intern_table_t *table, arena_t *arena);
+
+// Return unique id of identifier of given length (not NUL terminated), interns it when seen first time
+int intern(intern_table_t *table, const char *data, size_t length);
+
+// Return unique id of NUL terminated identifier
+int intern_string(intern_table_t *table, const char *text);
+
+// Canonical text of interned identifier, same id always gives the same pointer
+char *intern_text(intern_table_t *table, int id);
+
+// Release all interned identifiers
+void intern_free(intern_table_t *table);
+
+#endif
@@ -0,0 +1,61 @@
+/*
+* Project: Implementacia prekladaca imperativneho jazyka IFJ2024
+*
+* @author: Jakub Hrdlicka <xhrdli18>
+*
+*/
+
+#include <stdlib.h>
+#include "ir.h"
+
+
+// Initialize empty list
+void ir_init(ir_code_t *code, diag_t *diag){
+    code->items = NULL;
+    code->count = 0;
+    code->capacity = 0;
+    code->diag = diag;
+}
+
+// Append instruction, list grows on demand
+void ir_add3(ir_code_t *code, ir_opcode_t opcode, ir_operand_t a, ir_operand_t b, ir_operand_t c){
+    if (code->count == code->capacity){
+        int capacity = code->capacity == 0 ? 256 : code->capacity * 2;
+        ir_instr_t *items = (ir_instr_t *)realloc(code->items, capacity * sizeof(ir_instr_t));
+        if (items == NULL){
+            diag_raise(code->diag, 99, "Error: Allocation failed");
+        }
+        code->items = items;
+        code->capacity = capacity;
+    }
+    ir_instr_t *instr = &code->items[code->count++];
+    instr->opcode = opcode;
+    instr->operand[0] = a;
+    instr->operand[1] = b;
+    instr->operand[2] = c;
+}
+
+void ir_add2(ir_code_t *code, ir_opcode_t opcode, ir_operand_t a, ir_operand_t b){
+    ir_add3(code, opcode, a, b, ir_operand(ir_none));
+}
+
+void ir_add1(ir_code_t *code, ir_opcode_t opcode, ir_operand_t a){
+    ir_add3(code, opcode, a, ir_operand(ir_none), ir_operand(ir_none));
+}
+
+void ir_add0(ir_code_t *code, ir_opcode_t opcode){
+    ir_add3(code, opcode, ir_operand(ir_none), ir_operand(ir_none), ir_operand(ir_none));
+}
+
+// Remove all instructions
+void ir_clear(ir_code_t *code){
+    code->count = 0;
+}
+
+// Release list
+void ir_free(ir_code_t *code){
+    free(code->items);
+    code->items = NULL;
+    code->count = 0;
+    code->capacity = 0;
+}
\ No newline at end of file
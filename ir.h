@@ -0,0 +1,165 @@
+/*
+* Project: Implementacia prekladaca imperativneho jazyka IFJ2024
+*
+* @author: Jakub Hrdlicka <xhrdli18>
+*
+*/
+
+#ifndef IR_H
+#define IR_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "diag.h"
+#include "emit.h"
+
+// Instructions of IFJcode24, names are printed from ir_opcode_names in this order
+typedef enum ir_opcode {
+    IR_MOVE, IR_CREATEFRAME, IR_PUSHFRAME, IR_POPFRAME, IR_DEFVAR, IR_CALL, IR_RETURN,
+    IR_PUSHS, IR_POPS, IR_CLEARS,
+    IR_ADD, IR_SUB, IR_MUL, IR_DIV, IR_IDIV, IR_ADDS, IR_SUBS, IR_MULS, IR_DIVS, IR_IDIVS,
+    IR_LT, IR_GT, IR_EQ, IR_LTS, IR_GTS, IR_EQS,
+    IR_AND, IR_OR, IR_NOT, IR_ANDS, IR_ORS, IR_NOTS,
+    IR_INT2FLOAT, IR_FLOAT2INT, IR_INT2CHAR, IR_STRI2INT,
+    IR_INT2FLOATS, IR_FLOAT2INTS, IR_INT2CHARS, IR_STRI2INTS,
+    IR_READ, IR_WRITE, IR_CONCAT, IR_STRLEN, IR_GETCHAR, IR_SETCHAR, IR_TYPE,
+    IR_LABEL, IR_JUMP, IR_JUMPIFEQ, IR_JUMPIFNEQ, IR_JUMPIFEQS, IR_JUMPIFNEQS, IR_EXIT,
+    IR_BREAK, IR_DPRINT
+} ir_opcode_t;
+
+// Kinds of operands
+typedef enum ir_operand_kind {
+    ir_none,
+    ir_var,         // frame and name
+    ir_int,
+    ir_float,
+    ir_bool,
+    ir_nil,
+    ir_string,      // escaped text
+    ir_label,
+    ir_type         // int, float, string or bool of READ
+} ir_operand_kind_t;
+
+// Frames of variables
+typedef enum ir_frame {
+    IR_GF,
+    IR_LF,
+    IR_TF
+} ir_frame_t;
+
+// Operand of instruction
+// Names of variables and labels may end with number (labels of n-th if, n-th argument), index is -1 without it
+// Index of string is length of its text when the text is not NUL terminated, -1 otherwise
+typedef struct ir_operand {
+    uint8_t kind;
+    uint8_t frame;
+    int32_t index;
+    union {
+        const char *name;   // variable, label, type and text of string, not copied
+        int64_t int_value;  // int and bool
+        double float_value;
+    } value;
+} ir_operand_t;
+
+// Instruction with up to three operands, unused are ir_none
+typedef struct ir_instr {
+    uint8_t opcode;
+    ir_operand_t operand[3];
+} ir_instr_t;
+
+// List of instructions of one function (or of program prologue, built-in functions)
+typedef struct ir_code {
+    ir_instr_t *items;
+    int count;
+    int capacity;
+    diag_t *diag;       // allocation failure is reported here
+} ir_code_t;
+
+// Operand constructors
+static inline ir_operand_t ir_operand(ir_operand_kind_t kind){
+    ir_operand_t operand;
+    operand.kind = kind;
+    operand.frame = IR_GF;
+    operand.index = -1;
+    operand.value.int_value = 0;
+    return operand;
+}
+
+static inline ir_operand_t ir_var_n(ir_frame_t frame, const char *name, int index){
+    ir_operand_t operand = ir_operand(ir_var);
+    operand.frame = frame;
+    operand.index = index;
+    operand.value.name = name;
+    return operand;
+}
+
+static inline ir_operand_t ir_gf(const char *name){ return ir_var_n(IR_GF, name, -1); }
+static inline ir_operand_t ir_lf(const char *name){ return ir_var_n(IR_LF, name, -1); }
+
+static inline ir_operand_t ir_label_n(const char *name, int index){
+    ir_operand_t operand = ir_operand(ir_label);
+    operand.index = index;
+    operand.value.name = name;
+    return operand;
+}
+
+static inline ir_operand_t ir_label_name(const char *name){ return ir_label_n(name, -1); }
+
+static inline ir_operand_t ir_int_const(int64_t value){
+    ir_operand_t operand = ir_operand(ir_int);
+    operand.value.int_value = value;
+    return operand;
+}
+
+static inline ir_operand_t ir_float_const(double value){
+    ir_operand_t operand = ir_operand(ir_float);
+    operand.value.float_value = value;
+    return operand;
+}
+
+static inline ir_operand_t ir_bool_const(bool value){
+    ir_operand_t operand = ir_operand(ir_bool);
+    operand.value.int_value = value;
+    return operand;
+}
+
+static inline ir_operand_t ir_nil_const(){ return ir_operand(ir_nil); }
+
+static inline ir_operand_t ir_string_const(const char *text){
+    ir_operand_t operand = ir_operand(ir_string);
+    operand.value.name = text;
+    return operand;
+}
+
+static inline ir_operand_t ir_string_text(const char *text, size_t length){
+    ir_operand_t operand = ir_operand(ir_string);
+    operand.index = (int32_t)length;
+    operand.value.name = text;
+    return operand;
+}
+
+static inline ir_operand_t ir_type_name(const char *name){
+    ir_operand_t operand = ir_operand(ir_type);
+    operand.value.name = name;
+    return operand;
+}
+
+// Initialize empty list
+void ir_init(ir_code_t *code, diag_t *diag);
+
+// Append instruction with 0 to 3 operands
+void ir_add0(ir_code_t *code, ir_opcode_t opcode);
+void ir_add1(ir_code_t *code, ir_opcode_t opcode, ir_operand_t a);
+void ir_add2(ir_code_t *code, ir_opcode_t opcode, ir_operand_t a, ir_operand_t b);
+void ir_add3(ir_code_t *code, ir_opcode_t opcode, ir_operand_t a, ir_operand_t b, ir_operand_t c);
+
+// Remove all instructions, memory is kept for next function
+void ir_clear(ir_code_t *code);
+
+// Release list
+void ir_free(ir_code_t *code);
+
+// Print instructions as IFJcode24 text (ir_print.c)
+void ir_print(const ir_code_t *code, emitter_t *out);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,103 @@
+/*
+* Project: Implementacia prekladaca imperativneho jazyka IFJ2024
+*
+* @author: Jakub Hrdlicka <xhrdli18>
+*
+*/
+
+#include <string.h>
+#include "ir.h"
+
+
+// Names of instructions with their lengths, indexed by ir_opcode_t
+#define IR_NAME(name) {name, sizeof(name) - 1}
+static const struct {
+    const char *text;
+    size_t length;
+} ir_opcode_names[] = {
+    IR_NAME("MOVE"), IR_NAME("CREATEFRAME"), IR_NAME("PUSHFRAME"), IR_NAME("POPFRAME"), IR_NAME("DEFVAR"), IR_NAME("CALL"), IR_NAME("RETURN"),
+    IR_NAME("PUSHS"), IR_NAME("POPS"), IR_NAME("CLEARS"),
+    IR_NAME("ADD"), IR_NAME("SUB"), IR_NAME("MUL"), IR_NAME("DIV"), IR_NAME("IDIV"), IR_NAME("ADDS"), IR_NAME("SUBS"), IR_NAME("MULS"), IR_NAME("DIVS"), IR_NAME("IDIVS"),
+    IR_NAME("LT"), IR_NAME("GT"), IR_NAME("EQ"), IR_NAME("LTS"), IR_NAME("GTS"), IR_NAME("EQS"),
+    IR_NAME("AND"), IR_NAME("OR"), IR_NAME("NOT"), IR_NAME("ANDS"), IR_NAME("ORS"), IR_NAME("NOTS"),
+    IR_NAME("INT2FLOAT"), IR_NAME("FLOAT2INT"), IR_NAME("INT2CHAR"), IR_NAME("STRI2INT"),
+    IR_NAME("INT2FLOATS"), IR_NAME("FLOAT2INTS"), IR_NAME("INT2CHARS"), IR_NAME("STRI2INTS"),
+    IR_NAME("READ"), IR_NAME("WRITE"), IR_NAME("CONCAT"), IR_NAME("STRLEN"), IR_NAME("GETCHAR"), IR_NAME("SETCHAR"), IR_NAME("TYPE"),
+    IR_NAME("LABEL"), IR_NAME("JUMP"), IR_NAME("JUMPIFEQ"), IR_NAME("JUMPIFNEQ"), IR_NAME("JUMPIFEQS"), IR_NAME("JUMPIFNEQS"), IR_NAME("EXIT"),
+    IR_NAME("BREAK"), IR_NAME("DPRINT")
+};
+
+// Prefixes of variables, indexed by ir_frame_t
+static const char *ir_frame_names[] = {"GF@", "LF@", "TF@"};
+
+// Prints text of string constant of given length, white space, # and \ are written as \xyz
+void ir_print_string(const char *text, size_t length, emitter_t *out){
+    const char *run = text;
+    for (const char *end = text + length; text < end; text++){
+        unsigned char c = *text;
+        if (c <= 32 || c == 35 || c == 92){
+            emit_text(out, run, text - run);
+            char escaped[4] = {'\\', '0', '0' + (c / 10) % 10, '0' + c % 10};
+            emit_text(out, escaped, 4);
+            run = text + 1;
+        }
+    }
+    emit_text(out, run, text - run);
+}
+
+// Prints one operand with its frame or type prefix
+void ir_print_operand(const ir_operand_t *operand, emitter_t *out){
+    switch (operand->kind){
+        case ir_var:
+            emit_text(out, ir_frame_names[operand->frame], 3);
+            emit_str(out, operand->value.name);
+            break;
+        case ir_label:
+        case ir_type:
+            emit_str(out, operand->value.name);
+            break;
+        case ir_int:
+            emit_literal(out, "int@");
+            emit_int(out, operand->value.int_value);
+            break;
+        case ir_float:
+            emit_literal(out, "float@");
+            emit_float(out, operand->value.float_value);
+            break;
+        case ir_bool:
+            if (operand->value.int_value){
+                emit_literal(out, "bool@true");
+            }
+            else {
+                emit_literal(out, "bool@false");
+            }
+            break;
+        case ir_nil:
+            emit_literal(out, "nil@nil");
+            break;
+        case ir_string:
+            // Index of string is not a number suffix
+            emit_literal(out, "string@");
+            ir_print_string(operand->value.name, operand->index >= 0 ? (size_t)operand->index : strlen(operand->value.name), out);
+            return;
+        default:
+            return;
+    }
+    // Numbered variable or label
+    if (operand->index >= 0){
+        emit_int(out, operand->index);
+    }
+}
+
+// Prints instructions one per line
+void ir_print(const ir_code_t *code, emitter_t *out){
+    for (int i = 0; i < code->count; i++){
+        const ir_instr_t *instr = &code->items[i];
+        emit_text(out, ir_opcode_names[instr->opcode].text, ir_opcode_names[instr->opcode].length);
+        for (int j = 0; j < 3 && instr->operand[j].kind != ir_none; j++){
+            emit_literal(out, " ");
+            ir_print_operand(&instr->operand[j], out);
+        }
+        emit_literal(out, "\n");
+    }
+}
\ No newline at end of file
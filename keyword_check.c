@@ -9,18 +9,80 @@
 #include "token.h"
 #include "keyword_check.h"
 
-enum token_type kw_check(char *data){
-    if((strcmp(data, "i32") == 0) || (strcmp(data, "f64") == 0)){
-        return type_token;
-    }
+// Keyword table indexed by token kind
+typedef struct keyword_entry {
+    char *spelling;
+    enum token_type type;
+} keyword_entry_t;
+
+const keyword_entry_t keyword_table[] = {
+    [kind_none]   = {NULL,     identifier_token},
+    [kind_const]  = {"const",  keyword_token},
+    [kind_else]   = {"else",   keyword_token},
+    [kind_fn]     = {"fn",     keyword_token},
+    [kind_if]     = {"if",     keyword_token},
+    [kind_pub]    = {"pub",    keyword_token},
+    [kind_return] = {"return", keyword_token},
+    [kind_var]    = {"var",    keyword_token},
+    [kind_void]   = {"void",   keyword_token},
+    [kind_while]  = {"while",  keyword_token},
+    [kind_i32]    = {"i32",    type_token},
+    [kind_f64]    = {"f64",    type_token},
+    [kind_null]   = {"null",   null_token},
+};
 
-    if(strcmp(data, "null") == 0){
-        return null_token;
+// Perfect hash of keywords, length and first char select the only possible candidate
+token_kind_t kw_candidate(const char *data, size_t length){
+    switch (length) {
+        case 2:
+            switch (data[0]) {
+                case 'f': return kind_fn;
+                case 'i': return kind_if;
+            }
+            break;
+        case 3:
+            switch (data[0]) {
+                case 'i': return kind_i32;
+                case 'f': return kind_f64;
+                case 'p': return kind_pub;
+                case 'v': return kind_var;
+            }
+            break;
+        case 4:
+            switch (data[0]) {
+                case 'e': return kind_else;
+                case 'n': return kind_null;
+                case 'v': return kind_void;
+            }
+            break;
+        case 5:
+            switch (data[0]) {
+                case 'c': return kind_const;
+                case 'w': return kind_while;
+            }
+            break;
+        case 6:
+            if (data[0] == 'r') {
+                return kind_return;
+            }
+            break;
     }
+    return kind_none;
+}
 
-    if((strcmp(data, "const") == 0) || (strcmp(data, "else") == 0) || (strcmp(data, "fn") == 0) || (strcmp(data, "if") == 0) || (strcmp(data, "pub") == 0) || (strcmp(data, "return") == 0) || (strcmp(data, "var") == 0) || (strcmp(data, "void") == 0) || (strcmp(data, "while") == 0)){
-        return keyword_token;
+enum token_type kw_check(const char *data, size_t length, token_kind_t *kind){
+    token_kind_t candidate = kw_candidate(data, length);
+
+    // Only one comparison against the candidate, first char is already checked
+    if (candidate != kind_none && memcmp(data + 1, keyword_table[candidate].spelling + 1, length - 1) == 0){
+        *kind = candidate;
+        return keyword_table[candidate].type;
     }
 
+    *kind = kind_none;
     return identifier_token;
-}
\ No newline at end of file
+}
+
+char *kw_spelling(token_kind_t kind){
+    return keyword_table[kind].spelling;
+}
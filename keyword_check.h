@@ -8,8 +8,13 @@
 #ifndef KEYWORD_CHECK_H
 #define KEYWORD_CHECK_H
 
+#include <stddef.h>
 #include "token.h"
 
-enum token_type kw_check(char *data);
+// Classify word of given length (not NUL terminated), kind of keyword is saved to kind
+enum token_type kw_check(const char *data, size_t length, token_kind_t *kind);
 
-#endif
\ No newline at end of file
+// Static spelling of keyword
+char *kw_spelling(token_kind_t kind);
+
+#endif
@@ -6,6 +6,8 @@
 *
 */
 #include <ctype.h>
+#include <errno.h>
+#include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>
@@ -14,22 +16,166 @@
 #include "str_buffer.h"
 #include "token.h"
 #include "keyword_check.h"
+#include "source_reader.h"
+#include "intern.h"
+#include "arena.h"
 
-//create new token
-token_t* create_token(token_type_t type, char* data) {
-    token_t* token = (token_t*)malloc(sizeof(token_t));
-    if (token == NULL){
-        fprintf(stderr, "Failed to alloc space for token.\n");
-        exit(99);
-    }
+//create new token, its text is viewed in source from offset up to the cursor
+token_t* create_token(lexer_t *lexer, token_type_t type, char* data, size_t offset) {
+    token_t* token = (token_t*)arena_alloc(lexer->arena, sizeof(token_t));
     token->type = type;
+    token->kind = kind_none;
     token->data = data;
+    token->offset = offset;
+    token->length = lexer->source.pos - offset;
+    token->id = INTERN_NONE;
 
     return token;
 }
 
+//create int literal token, its value is parsed from source right away
+token_t *create_int_token(lexer_t *lexer, size_t offset){
+    source_reader_t *source = &lexer->source;
+    int64_t value = 0;
+    for (size_t i = offset; i < source->pos; i++){
+        int digit = source->data[i] - '0';
+        if (value > (INT64_MAX - digit) / 10){
+            diag_raise(lexer->diag, 1, "lexical error: integer literal out of range");
+        }
+        value = value * 10 + digit;
+    }
+
+    token_t *token = create_token(lexer, int_token, NULL, offset);
+    token->int_value = value;
+    return token;
+}
+
+//create float literal token, its value is parsed from source right away
+//strtod needs terminated text, it is copied to local buffer (or scratch buffer when longer)
+token_t *create_float_token(lexer_t *lexer, size_t offset){
+    source_reader_t *source = &lexer->source;
+    size_t length = source->pos - offset;
+    char buffer[64];
+    const char *text = buffer;
+    if (length < sizeof(buffer)){
+        memcpy(buffer, source->data + offset, length);
+        buffer[length] = '\0';
+    }
+    else {
+        str_buffer_t *scratch = lexer->scratch;
+        clear_str_buffer(scratch);
+        for (size_t i = offset; i < source->pos; i++){
+            append_to_str_buffer(scratch, source->data[i]);
+        }
+        text = scratch->string;
+    }
+
+    token_t *token = create_token(lexer, float_token, NULL, offset);
+    errno = 0;
+    token->float_value = strtod(text, NULL);
+    if (errno == ERANGE && isinf(token->float_value)){
+        diag_raise(lexer->diag, 1, "lexical error: float literal out of range");
+    }
+    return token;
+}
+
+//create identifier token, its text is the canonical interned text
+token_t *create_identifier_token(lexer_t *lexer, const char *text, size_t length, size_t offset){
+    int id = intern(lexer->intern, text, length);
+    token_t *token = create_token(lexer, identifier_token, intern_text(lexer->intern, id), offset);
+    token->id = id;
+    return token;
+}
+
+//create identifier/keyword token, neither of them copies its text
+token_t *create_word_token(lexer_t *lexer, size_t offset){
+    source_reader_t *source = &lexer->source;
+    token_kind_t kind;
+    token_type_t type = kw_check(source->data + offset, source->pos - offset, &kind);
+
+    if (kind == kind_none){
+        return create_identifier_token(lexer, source->data + offset, source->pos - offset, offset);
+    }
+    token_t *token = create_token(lexer, type, kw_spelling(kind), offset);
+    token->kind = kind;
+    return token;
+}
+
+//create string literal token, its text is rebuilt in scratch buffer
+//text without escape sequences is the same as in source and is viewed there, other text is copied
+token_t *create_string_token(lexer_t *lexer, size_t offset){
+    source_reader_t *source = &lexer->source;
+    str_buffer_t *scratch = lexer->scratch;
+    token_t *token = create_token(lexer, string_token, NULL, offset);
+    // every escape sequence is shorter in scratch than in source, quotes are not in scratch
+    if (source->data[offset] == '"' && scratch->size + 2 == token->length){
+        token->text = source->data + offset + 1;
+    }
+    else {
+        token->text = arena_strndup(lexer->arena, scratch->string, scratch->size);
+    }
+    token->text_length = scratch->size;
+    return token;
+}
+
+// Static spelling of tokens with fixed text, keywords are spelled by kw_spelling
+const char *spelling_table[] = {
+    [kind_nullable_i32]         = "?i32",
+    [kind_nullable_f64]         = "?f64",
+    [kind_string_type]          = "[]u8",
+    [kind_nullable_string_type] = "?[]u8",
+    [kind_import]               = "@import",
+    [kind_left_paren]           = "(",
+    [kind_right_paren]          = ")",
+    [kind_left_brace]           = "{",
+    [kind_right_brace]          = "}",
+    [kind_semicolon]            = ";",
+    [kind_colon]                = ":",
+    [kind_comma]                = ",",
+    [kind_dot]                  = ".",
+    [kind_pipe]                 = "|",
+    [kind_assign]               = "=",
+    [kind_plus]                 = "+",
+    [kind_minus]                = "-",
+    [kind_multiply]             = "*",
+    [kind_divide]               = "/",
+    [kind_equal]                = "==",
+    [kind_not_equal]            = "!=",
+    [kind_less]                 = "<",
+    [kind_greater]              = ">",
+    [kind_less_equal]           = "<=",
+    [kind_greater_equal]        = ">=",
+};
+
+//create token with fixed text, its spelling is static
+token_t *create_fixed_token(lexer_t *lexer, token_type_t type, token_kind_t kind, size_t offset){
+    token_t *token = create_token(lexer, type, (char *)spelling_table[kind], offset);
+    token->kind = kind;
+    return token;
+}
+
+//kind of token made of single char
+token_kind_t single_char_kind(char current_char){
+    switch (current_char) {
+        case ';': return kind_semicolon;
+        case '{': return kind_left_brace;
+        case '}': return kind_right_brace;
+        case '(': return kind_left_paren;
+        case ')': return kind_right_paren;
+        case ':': return kind_colon;
+        case '|': return kind_pipe;
+        case '.': return kind_dot;
+        case ',': return kind_comma;
+        case '+': return kind_plus;
+        case '-': return kind_minus;
+        case '*': return kind_multiply;
+        case '<': return kind_less;
+        default: return kind_greater;
+    }
+}
+
 //transform escape sequence
-char escape_sequence_transformation(char current_char){
+char escape_sequence_transformation(lexer_t *lexer, char current_char){
     switch (current_char) {
         case 'n':
             current_char = '\n';
@@ -50,51 +196,75 @@ char escape_sequence_transformation(char current_char){
             current_char = '"';
             break;
         default:
-            fprintf(stderr, "lexical error\n");
-            exit(1);
+            diag_raise(lexer->diag, 1, "lexical error");
             break;
     }
     return current_char;
 }
 
+//prepare lexer
+void lexer_init(lexer_t *lexer, arena_t *arena, intern_table_t *intern, diag_t *diag){
+    lexer->source.data = NULL;
+    lexer->source.length = 0;
+    lexer->source.pos = 0;
+    lexer->source.mapped = false;
+    lexer->source.borrowed = false;
+    lexer->scratch = create_str_buffer(diag);
+    lexer->arena = arena;
+    lexer->intern = intern;
+    lexer->diag = diag;
+}
+
+//release source and buffer of lexer
+void lexer_free(lexer_t *lexer){
+    source_close(&lexer->source);
+    if (lexer->scratch != NULL){
+        free_str_buffer(lexer->scratch);
+    }
+    lexer->scratch = NULL;
+}
+
 //return new token
-token_t* get_token(){
-    str_buffer_t* buffer = create_str_buffer();
+token_t* get_token(lexer_t *lexer){
+    str_buffer_t *scratch = lexer->scratch;
+    clear_str_buffer(scratch);
+    source_reader_t *source = &lexer->source;
+    size_t token_start = source->pos;
     lexer_state_t state = start;
     bool multiline = false;
-    char hex_val[3];
+    char hex_val[3] = {0};  // two hex digits and terminating NUL for strtol
     while(true){
-        char current_char = getchar();
+        // token starts at the first char read in starting state
+        if (state == start){
+            token_start = source->pos;
+        }
+        char current_char = source_getc(source);
 
         switch(state){
             //starting point
             case start:
                 if (current_char == EOF){
-                    return create_token(eof_token, NULL);
+                    source_ungetc(source);
+                    return create_token(lexer, eof_token, NULL, source->pos);
                 }
                 else if(current_char == 'i'){
                     state = built_in_function_f;
-                    append_to_str_buffer(buffer, current_char);
+                    append_to_str_buffer(scratch, current_char);
                 }
                 else if (current_char == '_' || isalpha(current_char)){
                     state = identifier;
-                    append_to_str_buffer(buffer, current_char);
                 }
                 else if (current_char == '['){
                     state = string_type;
-                    append_to_str_buffer(buffer, current_char);
                 }
                 else if (current_char == '?'){
                     state = question_mark;
-                    append_to_str_buffer(buffer, current_char);
                 }
                 else if (current_char == '0'){
                     state = zero;
-                    append_to_str_buffer(buffer, current_char);
                 }
                 else if (isdigit(current_char)){
                     state = integer;
-                    append_to_str_buffer(buffer, current_char);
                 }
                 else if (current_char == '"'){
                     state = string;
@@ -106,40 +276,31 @@ token_t* get_token(){
                     state = divide;
                 }
                 else if (current_char == ';'){
-                    append_to_str_buffer(buffer, current_char);
-                    return create_token(semicolon_token, buffer->string);
+                    return create_fixed_token(lexer, semicolon_token, single_char_kind(current_char), token_start);
                 }
                 else if (current_char == '{' || current_char == '}' || current_char == '(' || current_char == ')'){
-                    append_to_str_buffer(buffer, current_char);
-                    return create_token(bracket_token, buffer->string);
+                    return create_fixed_token(lexer, bracket_token, single_char_kind(current_char), token_start);
                 }
                 else if (current_char == ':'){
-                    append_to_str_buffer(buffer, current_char);
-                    return create_token(colon_token, buffer->string);
+                    return create_fixed_token(lexer, colon_token, single_char_kind(current_char), token_start);
                 }
                 else if (current_char == '|' || current_char == '.' || current_char == ','){
-                    append_to_str_buffer(buffer, current_char);
-                    return create_token(punctuation_token, buffer->string);
+                    return create_fixed_token(lexer, punctuation_token, single_char_kind(current_char), token_start);
                 }
                 else if (current_char == '+' || current_char == '-' || current_char == '*'){
-                    append_to_str_buffer(buffer, current_char);
-                    return create_token(binary_operator_token, buffer->string);
+                    return create_fixed_token(lexer, binary_operator_token, single_char_kind(current_char), token_start);
                 }
                 else if (current_char == '='){
                     state = equal;
-                    append_to_str_buffer(buffer, current_char);
                 }
                 else if (current_char == '!'){
                     state = not_equal;
-                    append_to_str_buffer(buffer, current_char);
                 }
                 else if (current_char == '@'){
                     state = import;
-                    append_to_str_buffer(buffer, current_char);
                 }
                 else if (current_char == '<' || current_char == '>'){
                     state = relational_operator;
-                    append_to_str_buffer(buffer, current_char);
                 }
                 else if (current_char == 9 || current_char == 32 || current_char == '\n' || current_char == '\r'){
                     state = start;
@@ -148,163 +309,147 @@ token_t* get_token(){
                     return NULL;
                 }
                 else{
-                    fprintf(stderr, "lexical error\n");
-                    exit(1);
+                    diag_raise(lexer->diag, 1, "lexical error");
                 }
                 break;
 
             //identifier/keyword/underscore
             case identifier:
                 if (current_char == '_' || isalpha(current_char) || isdigit(current_char)){
-                    append_to_str_buffer(buffer, current_char);
+                    // still part of token, text is viewed in source
                 }
                 else{
-                    ungetc(current_char, stdin);
-                    return create_token(kw_check(buffer->string), buffer->string);
+                    source_ungetc(source);
+                    return create_word_token(lexer, token_start);
                 }
                 break;
 
             //handling numbers
             case zero:
                 if (current_char == '0'){
-                    append_to_str_buffer(buffer, current_char);
+                    // still part of token, text is viewed in source
                 }
                 else if (isdigit(current_char)){
-                    fprintf(stderr, "lexical error\n");
-                    exit(1);
+                    diag_raise(lexer->diag, 1, "lexical error");
                 }
                 else if (current_char == 'e' || current_char == 'E'){
                     state = exponent_number_check;
-                    append_to_str_buffer(buffer, current_char);
                 }
                 else if (current_char == '.'){
                     state = decimal_number_check;
-                    append_to_str_buffer(buffer, current_char);
                 }
                 else{
-                    ungetc(current_char, stdin);
-                    return create_token(int_token, buffer->string);
+                    source_ungetc(source);
+                    return create_int_token(lexer, token_start);
                 }
                 break;
 
             case integer:
                 if (isdigit(current_char)){
-                    append_to_str_buffer(buffer, current_char);
+                    // still part of token, text is viewed in source
                 }
                 else if (current_char == 'e' || current_char == 'E'){
                     state = exponent_number_check;
-                    append_to_str_buffer(buffer, current_char);
                 }
                 else if (current_char == '.'){
                     state = decimal_number_check;
-                    append_to_str_buffer(buffer, current_char);
                 }
                 else{
-                    ungetc(current_char, stdin);
-                    return create_token(int_token, buffer->string);
+                    source_ungetc(source);
+                    return create_int_token(lexer, token_start);
                 }
                 break;
 
             case decimal_number_check:
                 if (isdigit(current_char)){
                     state = decimal_number;
-                    append_to_str_buffer(buffer, current_char);
                 }
                 else{
-                    fprintf(stderr, "lexical error\n");
-                    exit(1);
+                    diag_raise(lexer->diag, 1, "lexical error");
                 }
                 break;
 
             case decimal_number:
                 if (isdigit(current_char)){
-                    append_to_str_buffer(buffer, current_char);
+                    // still part of token, text is viewed in source
                 }
                 else if (current_char == 'e' || current_char == 'E'){
                     state = exponent_number_check;
-                    append_to_str_buffer(buffer, current_char);
                 }
                 else{
-                    ungetc(current_char, stdin);
-                    return create_token(float_token, buffer->string);
+                    source_ungetc(source);
+                    return create_float_token(lexer, token_start);
                 }
                 break;
 
             case exponent_number_check:
                 if (current_char == '+' || current_char == '-'){
                     state = signed_exponent_number;
-                    append_to_str_buffer(buffer, current_char);
                 }
                 else if (isdigit(current_char)){
                     state = exponent_number;
-                    append_to_str_buffer(buffer, current_char);
                 }
                 else{
-                    fprintf(stderr, "lexical error\n");
-                    exit(1);
+                    diag_raise(lexer->diag, 1, "lexical error");
                 }
                 break;
 
             case signed_exponent_number:
                 if (isdigit(current_char)){
                     state = exponent_number;
-                    append_to_str_buffer(buffer, current_char);
                 }
                 else{
-                    fprintf(stderr, "lexical error\n");
-                    exit(1);
+                    diag_raise(lexer->diag, 1, "lexical error");
                 }
                 break;
 
             case exponent_number:
                 if (isdigit(current_char)){
-                    append_to_str_buffer(buffer, current_char);
+                    // still part of token, text is viewed in source
                 }
                 else{
-                    ungetc(current_char, stdin);
-                    return create_token(float_token, buffer->string);
+                    source_ungetc(source);
+                    return create_float_token(lexer, token_start);
                 }
                 break;
 
             //handling string
             case string: 
                 if (current_char == '"'){
-                    return create_token(string_token, buffer->string);
+                    return create_string_token(lexer, token_start);
                 }
                 else if (current_char == '\\'){
                     state = escape_sequence;
                 }
                 else if (current_char < 32 || current_char == '\n'){
-                    fprintf(stderr, "lexical error\n");
-                    exit(1);
+                    diag_raise(lexer->diag, 1, "lexical error");
                 }
                 else {
-                    append_to_str_buffer(buffer, current_char);
+                    append_to_str_buffer(scratch, current_char);
                 }
                 break;
 
             case escape_sequence:
                 if ((current_char == '\'' || current_char == '"' || current_char == 'n' || current_char == 'r' || current_char == 't' || current_char == '\\') && (multiline == false)){
                     state = string;
-                    current_char = escape_sequence_transformation(current_char);
-                    append_to_str_buffer(buffer, current_char);
+                    current_char = escape_sequence_transformation(lexer, current_char);
+                    append_to_str_buffer(scratch, current_char);
                 }
                 else if ((current_char == '\'' || current_char == '"' || current_char == 'n' || current_char == 'r' || current_char == 't' || current_char == '\\') && (multiline == true)){
                     multiline = false;
                     state = multiline_string;
-                    current_char = escape_sequence_transformation(current_char);
-                    append_to_str_buffer(buffer, current_char);
+                    current_char = escape_sequence_transformation(lexer, current_char);
+                    append_to_str_buffer(scratch, current_char);
                 }
                 else if (current_char == 'x'){
                     state = escape_sequence2x;
                 }
                 else if (current_char == 'u'){
                     state = escape_sequence3u;
-                    append_to_str_buffer(buffer, current_char);
+                    append_to_str_buffer(scratch, current_char);
                 }
                 else {
-                    fprintf(stderr, "lexical error\n");
-                    exit(1);
+                    diag_raise(lexer->diag, 1, "lexical error");
                 }
                 break;
 
@@ -314,8 +459,7 @@ token_t* get_token(){
                     hex_val[0] = current_char;
                 }
                 else {
-                    fprintf(stderr, "lexical error\n");
-                    exit(1);
+                    diag_raise(lexer->diag, 1, "lexical error");
                 }
                 break;
 
@@ -326,54 +470,51 @@ token_t* get_token(){
                     hex_val[1] = current_char;
                     int ascii_value = (int)strtol(hex_val, NULL, 16);
                     current_char = (char)ascii_value;
-                    append_to_str_buffer(buffer, current_char);
+                    append_to_str_buffer(scratch, current_char);
                 }
                 else if ((isdigit(current_char) || (current_char >= 'a' && current_char <= 'f') || (current_char >= 'A' && current_char <= 'F')) && (multiline == false)){
                     state = string;
                     hex_val[1] = current_char;
                     int ascii_value = (int)strtol(hex_val, NULL, 16);
                     current_char = (char)ascii_value;
-                    append_to_str_buffer(buffer, current_char);
+                    append_to_str_buffer(scratch, current_char);
                 }
                 else {
-                    fprintf(stderr, "lexical error\n");
-                    exit(1);
+                    diag_raise(lexer->diag, 1, "lexical error");
                 }
                 break;
 
             case escape_sequence3u:
                 if (current_char == '{'){
                     state = escape_sequence3;
-                    append_to_str_buffer(buffer, current_char);
+                    append_to_str_buffer(scratch, current_char);
                 }
                 else{
-                    fprintf(stderr, "lexical error\n");
-                    exit(1);
+                    diag_raise(lexer->diag, 1, "lexical error");
                 }
                 break;
             
             case escape_sequence3:
                 if (isdigit(current_char) || (current_char >= 'a' && current_char <= 'f') || (current_char >= 'A' && current_char <= 'F')){
-                    append_to_str_buffer(buffer, current_char);
+                    append_to_str_buffer(scratch, current_char);
                 }
                 else if ((current_char == '}') && (multiline == false)){
                     state = escape_sequence3_end;
-                    append_to_str_buffer(buffer, current_char);
+                    append_to_str_buffer(scratch, current_char);
                 }
                 else if ((current_char == '}') && (multiline == true)){
                     multiline = false;
                     state = multiline_string;
-                    append_to_str_buffer(buffer, current_char);
+                    append_to_str_buffer(scratch, current_char);
                 }
                 else{
-                    fprintf(stderr, "lexical error\n");
-                    exit(1);
+                    diag_raise(lexer->diag, 1, "lexical error");
                 }
                 break;
 
             case escape_sequence3_end:
                  if (current_char == '"'){
-                    return create_token(string_token, buffer->string);
+                    return create_string_token(lexer, token_start);
                 }
                 else if (current_char == '\\'){
                     state = escape_sequence;
@@ -382,8 +523,7 @@ token_t* get_token(){
                     state = string;
                 }
                 else{
-                    fprintf(stderr, "lexical error\n");
-                    exit(1);
+                    diag_raise(lexer->diag, 1, "lexical error");
                 }
                 break;
 
@@ -392,8 +532,7 @@ token_t* get_token(){
                     state = multiline_string;
                 }
                 else{
-                    fprintf(stderr, "lexical error\n");
-                    exit(1);
+                    diag_raise(lexer->diag, 1, "lexical error");
                 }
                 break;
 
@@ -402,7 +541,7 @@ token_t* get_token(){
                     state = multiline_string_end;
                 }
                 else if (current_char == '\r'){
-                    current_char = getchar();
+                    current_char = source_getc(source);
                     if (current_char == '\n'){
                         state = multiline_string_end;
                     }
@@ -412,25 +551,24 @@ token_t* get_token(){
                     state = escape_sequence;
                 }
                 else if (current_char > 31){
-                    append_to_str_buffer(buffer, current_char);
+                    append_to_str_buffer(scratch, current_char);
                 }
                 else if (current_char ==  EOF){
-                    return create_token(string_token, buffer->string);
+                    return create_string_token(lexer, token_start);
                 }
                 else{
-                    fprintf(stderr, "lexical error\n");
-                    exit(1);
+                    diag_raise(lexer->diag, 1, "lexical error");
                 }
                 break;
 
             case multiline_string_end:
                 if (current_char == '\\'){
                     state = multiline_string_check;
-                    append_to_str_buffer(buffer, '\n');
+                    append_to_str_buffer(scratch, '\n');
                 }
                 else{
-                    ungetc(current_char, stdin);
-                    return create_token(string_token, buffer->string);
+                    source_ungetc(source);
+                    return create_string_token(lexer, token_start);
                 }
                 break;
 
@@ -440,9 +578,8 @@ token_t* get_token(){
                     state = comment;
                 }
                 else{
-                    ungetc(current_char, stdin);
-                    append_to_str_buffer(buffer, '/');
-                    return create_token(binary_operator_token, buffer->string);
+                    source_ungetc(source);
+                    return create_fixed_token(lexer, binary_operator_token, kind_divide, token_start);
                 }
                 break;
 
@@ -454,34 +591,30 @@ token_t* get_token(){
 
             case equal:
                 if (current_char == '='){
-                    append_to_str_buffer(buffer, current_char);
-                    return create_token(double_equal_token, buffer->string);
+                    return create_fixed_token(lexer, double_equal_token, kind_equal, token_start);
                 }
                 else{
-                    ungetc(current_char, stdin);
-                    return create_token(equal_token, buffer->string);
+                    source_ungetc(source);
+                    return create_fixed_token(lexer, equal_token, kind_assign, token_start);
                 }
                 break;
 
             case not_equal:
                 if (current_char == '='){
-                    append_to_str_buffer(buffer, current_char);
-                    return create_token(not_equal_token, buffer->string);
+                    return create_fixed_token(lexer, not_equal_token, kind_not_equal, token_start);
                 }
                 else{
-                    fprintf(stderr, "lexical error\n");
-                    exit(1);
+                    diag_raise(lexer->diag, 1, "lexical error");
                 }
                 break;
 
             case relational_operator:
                 if (current_char == '='){
-                    append_to_str_buffer(buffer, current_char);
-                    return create_token(relational_operator_token, buffer->string);
+                    return create_fixed_token(lexer, relational_operator_token, source->data[token_start] == '<' ? kind_less_equal : kind_greater_equal, token_start);
                 }
                 else{
-                    ungetc(current_char, stdin);
-                    return create_token(relational_operator_token, buffer->string);
+                    source_ungetc(source);
+                    return create_fixed_token(lexer, relational_operator_token, single_char_kind(source->data[token_start]), token_start);
                 }
                 break;
 
@@ -489,96 +622,78 @@ token_t* get_token(){
             case string_type:
                 if (current_char == ']'){
                     state = string_type_u;
-                    append_to_str_buffer(buffer, current_char);
                 }
                 else{
-                    fprintf(stderr, "lexical error\n");
-                    exit(1);
+                    diag_raise(lexer->diag, 1, "lexical error");
                 }
                 break;
 
             case string_type_u:
                 if (current_char == 'u'){
                     state = string_type_8;
-                    append_to_str_buffer(buffer, current_char);
                 }
                 else{
-                    fprintf(stderr, "lexical error\n");
-                    exit(1);
+                    diag_raise(lexer->diag, 1, "lexical error");
                 }
                 break;
 
             case string_type_8:
                 if (current_char == '8'){
-                    append_to_str_buffer(buffer, current_char);
-                    return create_token(type_token, buffer->string);
+                    return create_fixed_token(lexer, type_token, source->data[token_start] == '?' ? kind_nullable_string_type : kind_string_type, token_start);
                 }
                 else{
-                    fprintf(stderr, "lexical error\n");
-                    exit(1);
+                    diag_raise(lexer->diag, 1, "lexical error");
                 }
                 break;
 
             case question_mark:
                 if (current_char == '['){
                     state = string_type;
-                    append_to_str_buffer(buffer, current_char);
                 }
                 else if (current_char == 'i'){
                     state = int_type;
-                    append_to_str_buffer(buffer, current_char);
                 }
                 else if (current_char == 'f'){
                     state = float_type;
-                    append_to_str_buffer(buffer, current_char);
                 }
                 else{
-                    fprintf(stderr, "lexical error\n");
-                    exit(1);
+                    diag_raise(lexer->diag, 1, "lexical error");
                 }
                 break;
 
             case int_type:
                 if (current_char == '3'){
                     state = int_type_3;
-                    append_to_str_buffer(buffer, current_char);
                 }
                 else{
-                    fprintf(stderr, "lexical error\n");
-                    exit(1);
+                    diag_raise(lexer->diag, 1, "lexical error");
                 }
                 break;
             
             case int_type_3:
                 if (current_char == '2'){
-                    append_to_str_buffer(buffer, current_char);
-                    return create_token(type_token, buffer->string);
+                    return create_fixed_token(lexer, type_token, kind_nullable_i32, token_start);
                 }
                 else{
-                    fprintf(stderr, "lexical error\n");
-                    exit(1);
+                    diag_raise(lexer->diag, 1, "lexical error");
                 }
                 break;
 
             case float_type:
                 if (current_char == '6'){
                     state = float_type_6;
-                    append_to_str_buffer(buffer, current_char);
                 }
                 else{
-                    fprintf(stderr, "lexical error\n");
-                    exit(1);
+                    diag_raise(lexer->diag, 1, "lexical error");
                 }
                 break;
             
             case float_type_6:
                 if (current_char == '4'){
-                    append_to_str_buffer(buffer, current_char);
-                    return create_token(type_token, buffer->string);
+                    return create_fixed_token(lexer, type_token, kind_nullable_f64, token_start);
                 }
                 else{
-                    fprintf(stderr, "lexical error\n");
-                    exit(1);
+                    diag_raise(lexer->diag, 1, "lexical error");
                 }
                 break;
 
@@ -586,66 +701,54 @@ token_t* get_token(){
             case import:
                 if (current_char == 'i'){
                     state = import_m;
-                    append_to_str_buffer(buffer, current_char);
                 }
                 else{
-                    fprintf(stderr, "lexical error\n");
-                    exit(1);
+                    diag_raise(lexer->diag, 1, "lexical error");
                 }
                 break;
 
             case import_m:
                 if (current_char == 'm'){
                     state = import_p;
-                    append_to_str_buffer(buffer, current_char);
                 }
                 else{
-                    fprintf(stderr, "lexical error\n");
-                    exit(1);
+                    diag_raise(lexer->diag, 1, "lexical error");
                 }
                 break;
 
             case import_p:
                 if (current_char == 'p'){
                     state = import_o;
-                    append_to_str_buffer(buffer, current_char);
                 }
                 else{
-                    fprintf(stderr, "lexical error\n");
-                    exit(1);
+                    diag_raise(lexer->diag, 1, "lexical error");
                 }
                 break;
 
             case import_o:
                 if (current_char == 'o'){
                     state = import_r;
-                    append_to_str_buffer(buffer, current_char);
                 }
                 else{
-                    fprintf(stderr, "lexical error\n");
-                    exit(1);
+                    diag_raise(lexer->diag, 1, "lexical error");
                 }
                 break;
 
             case import_r:
                 if (current_char == 'r'){
                     state = import_end;
-                    append_to_str_buffer(buffer, current_char);
                 }
                 else{
-                    fprintf(stderr, "lexical error\n");
-                    exit(1);
+                    diag_raise(lexer->diag, 1, "lexical error");
                 }
                 break;
 
             case import_end:
                 if (current_char == 't'){
-                    append_to_str_buffer(buffer, current_char);
-                    return create_token(import_token, buffer->string);
+                    return create_fixed_token(lexer, import_token, kind_import, token_start);
                 }
                 else{
-                    fprintf(stderr, "lexical error\n");
-                    exit(1);
+                    diag_raise(lexer->diag, 1, "lexical error");
                 }
                 break;
 
@@ -653,62 +756,60 @@ token_t* get_token(){
             case built_in_function_f:
                 if (current_char == 'f'){
                     state = built_in_function_j;
-                    append_to_str_buffer(buffer, current_char);
+                    append_to_str_buffer(scratch, current_char);
                 }
                 else if (current_char == '_' || isalpha(current_char) || isdigit(current_char)){
                     state = identifier;
-                    append_to_str_buffer(buffer, current_char);
                 }
                 else {
-                    ungetc(current_char, stdin);
-                    return create_token(kw_check(buffer->string), buffer->string);
+                    source_ungetc(source);
+                    return create_word_token(lexer, token_start);
                 }
                 break;
             
             case built_in_function_j:
                 if (current_char == 'j'){
                     state = built_in_function_dot1;
-                    append_to_str_buffer(buffer, current_char);
+                    append_to_str_buffer(scratch, current_char);
                 }
                 else if (current_char == '_' || isalpha(current_char) || isdigit(current_char)){
                     state = identifier;
-                    append_to_str_buffer(buffer, current_char);
                 }
                 else{
-                    ungetc(current_char, stdin);
-                    return create_token(kw_check(buffer->string), buffer->string);
+                    source_ungetc(source);
+                    return create_word_token(lexer, token_start);
                 }
                 break;
             
             case built_in_function_dot1:
                 if (current_char == '.'){
                     state = built_in_function;
-                    append_to_str_buffer(buffer, '$');
+                    append_to_str_buffer(scratch, '$');
                 }
                 else if (current_char == '_' || isalpha(current_char) || isdigit(current_char)){
                     state = identifier;
-                    append_to_str_buffer(buffer, current_char);
                 }
                 else if (current_char == 9 || current_char == 32 || current_char == '\n' || current_char == '\r'){
                     state = built_in_function_dot;
                 }
                 else{
-                    ungetc(current_char, stdin);
-                    return create_token(kw_check(buffer->string), buffer->string);
+                    source_ungetc(source);
+                    return create_word_token(lexer, token_start);
                 }
                 break;
 
             case built_in_function_dot:
                 if (current_char == '.'){
                     state = built_in_function;
-                    append_to_str_buffer(buffer, '$');
+                    append_to_str_buffer(scratch, '$');
                 }
                 else if (current_char == 9 || current_char == 32 || current_char == '\n' || current_char == '\r'){
                     state = built_in_function_dot;
                 }
                 else{
-                    ungetc(current_char, stdin);
-                    return create_token(kw_check(buffer->string), buffer->string);
+                    // source view contains skipped whitespace, name is taken from scratch
+                    source_ungetc(source);
+                    return create_identifier_token(lexer, scratch->string, scratch->size, token_start);
                 }
                 break;
 
@@ -717,23 +818,22 @@ token_t* get_token(){
                 }
                 else if (current_char == '_' || isalpha(current_char) || isdigit(current_char)){
                     state = built_in_function_end;
-                    append_to_str_buffer(buffer, current_char);
+                    append_to_str_buffer(scratch, current_char);
                 }
                 else{
-                    fprintf(stderr, "lexical error\n");
-                    exit(1);
+                    diag_raise(lexer->diag, 1, "lexical error");
                 }
                 break;
 
             case built_in_function_end:
                 if (current_char == '_' || isalpha(current_char) || isdigit(current_char)){
-                    append_to_str_buffer(buffer, current_char);
+                    append_to_str_buffer(scratch, current_char);
                 }
                 else if (current_char == 9 || current_char == 32 || current_char == '\n' || current_char == '\r'){
                 }
                 else{
-                    ungetc(current_char, stdin);
-                    return create_token(kw_check(buffer->string), buffer->string);
+                    source_ungetc(source);
+                    return create_identifier_token(lexer, scratch->string, scratch->size, token_start);
                 }
                 break;
         }
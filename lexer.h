@@ -9,6 +9,19 @@
 #ifndef LEXER_H
 #define LEXER_H
 #include "token.h"
+#include "source_reader.h"
+#include "str_buffer.h"
+#include "intern.h"
+#include "arena.h"
+
+// State of lexical analysis of one source
+typedef struct lexer {
+    source_reader_t source;     // loaded source and cursor
+    str_buffer_t *scratch;      // reusable buffer for text that has to be rebuilt (strings, built-in function names)
+    arena_t *arena;             // tokens and their text
+    intern_table_t *intern;     // identifiers
+    diag_t *diag;               // lexical and syntax errors
+} lexer_t;
 
 typedef enum lexer_state {
     start,
@@ -57,8 +70,14 @@ typedef enum lexer_state {
     built_in_function_end
 } lexer_state_t;
 
+//prepare lexer, source is loaded by source_open
+void lexer_init(lexer_t *lexer, arena_t *arena, intern_table_t *intern, diag_t *diag);
+
 //return new token
-token_t *get_token();
+token_t *get_token(lexer_t *lexer);
+
+//release source and buffer of lexer
+void lexer_free(lexer_t *lexer);
 
 
 #endif
\ No newline at end of file
@@ -0,0 +1,59 @@
+/*
+* Project: Implementacia prekladaca imperativneho jazyka IFJ2024
+*
+* @author: Jakub Hrdlicka <xhrdli18>
+*
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include "ifj.h"
+#include "source_reader.h"
+
+
+// Usage: test [-o output] [source]
+// Source is read from stdin and code written to stdout when they are not given
+int main(int argc, char *argv[]){
+    const char *input = NULL;
+    const char *output = NULL;
+    for (int i = 1; i < argc; i++){
+        if (strcmp(argv[i], "-o") == 0 && i + 1 < argc && output == NULL){
+            output = argv[++i];
+        }
+        else if (strcmp(argv[i], "-o") != 0 && input == NULL){
+            input = argv[i];
+        }
+        else {
+            // Missing name after -o, second output or second source
+            fprintf(stderr, "Usage: %s [-o output] [source]\n", argv[0]);
+            return 99;
+        }
+    }
+
+    source_reader_t source;
+    source_open(&source, input);
+
+    int fd = STDOUT_FILENO;
+    if (output != NULL){
+        fd = open(output, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0){
+            fprintf(stderr, "Failed to open output file %s.\n", output);
+            source_close(&source);
+            return 99;
+        }
+    }
+
+    ifj_diag_t diag;
+    int code = ifj_compile_fd(source.data, source.length, fd, &diag);
+    source_close(&source);
+    if (output != NULL){
+        close(fd);
+    }
+
+    if (code != 0 && diag.message[0] != '\0'){
+        fprintf(stderr, "%s\n", diag.message);
+    }
+    return code;
+}
\ No newline at end of file
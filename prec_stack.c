@@ -0,0 +1,78 @@
+/*
+* Project: Implementacia prekladaca imperativneho jazyka IFJ2024
+*
+* @author: Rebeka Tydorova <xtydor01>
+*
+*/
+#include "prec_stack.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+//initialize stack, small stacks live in the structure itself
+void prec_Stack_Init(prec_Stack *stack, arena_t *arena) {
+	stack->arena = arena;
+	stack->symbol = stack->inline_symbol;
+	stack->token = stack->inline_token;
+	stack->size = PREC_STACK_INLINE;
+	stack->topIndex = -1;
+}
+
+//resize stack, bigger stack is taken from arena so nothing leaks when expression has error
+void prec_Stack_Resize(prec_Stack *stack) {
+	unsigned char *symbol = (unsigned char *)arena_alloc(stack->arena, stack->size * 2);
+	token_t **token = (token_t **)arena_alloc(stack->arena, stack->size * 2 * sizeof(token_t *));
+	memcpy(symbol, stack->symbol, stack->size);
+	memcpy(token, stack->token, stack->size * sizeof(token_t *));
+	stack->symbol = symbol;
+	stack->token = token;
+	stack->size *= 2;
+}
+
+//push a new symbol with its token onto the stack
+void prec_Stack_Push(prec_Stack *stack, prec_symbol_t symbol, token_t *token) {
+	if (stack->topIndex + 1 == stack->size){
+		prec_Stack_Resize(stack);
+	}
+	stack->topIndex++;
+	stack->symbol[stack->topIndex] = symbol;
+	stack->token[stack->topIndex] = token;
+}
+
+//return the topmost terminal in the stack
+prec_symbol_t prec_Stack_Top_Terminal(const prec_Stack *stack) {
+	for (int stack_idx = stack->topIndex; stack_idx >= 0; stack_idx--) {
+		if (stack->symbol[stack_idx] < prec_expression) {
+			return stack->symbol[stack_idx];
+		}
+	}
+	return prec_end;
+}
+
+//inserts a stop sign after the topmost terminal
+void prec_Stack_Insert_Stop(prec_Stack *stack) {
+	if (stack->symbol[stack->topIndex] != prec_expression){
+		prec_Stack_Push(stack, prec_stop, NULL);
+	}
+	else{
+		stack->symbol[stack->topIndex] = prec_stop;
+		prec_Stack_Push(stack, prec_expression, NULL);
+	}
+}
+
+//return index of the topmost stop sign, 0 if there is none
+int prec_Stack_Find_Stop(const prec_Stack *stack) {
+	for (int stack_idx = stack->topIndex; stack_idx >= 0; stack_idx--) {
+		if (stack->symbol[stack_idx] == prec_stop) {
+			return stack_idx;
+		}
+	}
+	return 0;
+}
+
+//dispose stack, spilled stack is released with arena
+void prec_Stack_Dispose(prec_Stack *stack) {
+	stack->symbol = NULL;
+	stack->token = NULL;
+	stack->topIndex = -1;
+}
@@ -0,0 +1,69 @@
+/*
+* Project: Implementacia prekladaca imperativneho jazyka IFJ2024
+*
+* @author: Rebeka Tydorova <xtydor01>
+*
+*/
+#ifndef _PREC_STACK_H_
+#define _PREC_STACK_H_
+
+#include <stdbool.h>
+#include "token.h"
+#include "arena.h"
+
+//symbols of precedence analysis, terminals are in order of precedence table
+typedef enum prec_symbol {
+	prec_multiply,
+	prec_divide,
+	prec_plus,
+	prec_minus,
+	prec_equal,
+	prec_not_equal,
+	prec_less,
+	prec_greater,
+	prec_less_equal,
+	prec_greater_equal,
+	prec_left_paren,
+	prec_right_paren,
+	prec_operand,		//i
+	prec_end,			//$
+	prec_expression,	//E, nonterminal
+	prec_stop			//[, start of handle
+} prec_symbol_t;
+
+//number of terminals (rows and columns of precedence table)
+#define PREC_TERMINALS (prec_end + 1)
+
+//number of symbols kept without allocation
+#define PREC_STACK_INLINE 32
+
+//stack, every symbol keeps token it was shifted from (NULL for E and [)
+typedef struct {
+	unsigned char *symbol;
+	token_t **token;
+	unsigned char inline_symbol[PREC_STACK_INLINE];
+	token_t *inline_token[PREC_STACK_INLINE];
+	int size;
+	int topIndex;
+	arena_t *arena;		//memory of stacks bigger than PREC_STACK_INLINE
+} prec_Stack;
+
+//initialize stack
+void prec_Stack_Init(prec_Stack *stack, arena_t *arena);
+
+//push a new symbol with its token onto the stack
+void prec_Stack_Push(prec_Stack *stack, prec_symbol_t symbol, token_t *token);
+
+//return the topmost terminal in the stack
+prec_symbol_t prec_Stack_Top_Terminal(const prec_Stack *stack);
+
+//inserts a stop sign after the topmost terminal
+void prec_Stack_Insert_Stop(prec_Stack *stack);
+
+//return index of the topmost stop sign, 0 if there is none
+int prec_Stack_Find_Stop(const prec_Stack *stack);
+
+//dispose stack
+void prec_Stack_Dispose(prec_Stack *stack);
+
+#endif
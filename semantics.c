@@ -9,6 +9,7 @@
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
+#include <setjmp.h>
 
 #include "ast.h"
 #include "token.h"
@@ -16,58 +17,125 @@
 #include "symtable_stack.h"
 #include "hashtable.h"
 #include "semantics.h"
-
-// Global variable for keeping track of the current function name
-char *current_function_name;
+#include "intern.h"
+#include "arena.h"
+#include "builtins.h"
+#include "compiler.h"
+
+// Operand of expression, its type and whether it is variable, constant or literal
+typedef struct type_entry {
+    unsigned char type;
+    unsigned char var_type;
+} type_entry_t;
+
+// Stack of operand types for checking expressions, grows on demand and is reused
+typedef struct type_stack {
+    type_entry_t *items;
+    int size;
+    int top;
+} type_stack_t;
+
+// State of semantic analysis of one compilation
+typedef struct semantic {
+    ht_table_t table;               // all visible symbols
+    sym_stack_t stack;              // declarations of open scopes
+    ht_item_t *current_function;    // symbol of the function we are currently in
+    // For keeping track of scopes, so we can check missing return keyword
+    int scope_cnt;
+    bool found_return;
+    bool in_if;
+    bool return_in_if;
+    type_stack_t type_stack;
+    compiler_t *compiler;
+} semantic_t;
 
 // Function declarations
-void get_fun_declarations(AST *ast, ht_table_t *table);
-void save_fun_dec(AST *ast, ht_table_t *table);
-void get_builtin_fun_declarations(ht_table_t *table);
-void analyze_code(AST *ast, ht_table_t *table, sym_stack_t *stack);
-void var_definition(AST *ast, ht_table_t *table, sym_stack_t *stack);
-symtable_type_t check_expression(AST *ast, ht_table_t *table, sym_stack_t *stack);
-void new_scope_if_while(AST *ast, ht_table_t *table, sym_stack_t *stack);
-void new_scope_function(AST *ast, ht_table_t *table, sym_stack_t *stack);
-void check_return_expr(AST *ast, ht_table_t *table, sym_stack_t *stack);
-void assignment_or_expression(AST *ast, ht_table_t *table, sym_stack_t *stack);
-void check_function_call_args(AST *ast, ht_table_t *table, sym_stack_t *stack);
+void analyze_guarded(semantic_t *sem);
+void free_semantic(semantic_t *sem);
+void analyze_program(AST *ast, semantic_t *sem);
+void save_fun_dec(AST *ast, ast_index_t node, semantic_t *sem);
+symtable_type_t kind_to_type(token_kind_t kind);
+void analyze_code(AST *ast, ast_index_t node, semantic_t *sem);
+void end_of_scope(semantic_t *sem);
+void var_definition(AST *ast, ast_index_t node, semantic_t *sem);
+symtable_type_t check_expression(AST *ast, ast_index_t node, semantic_t *sem);
+void new_scope_if_while(AST *ast, ast_index_t node, semantic_t *sem);
+void new_scope_function(AST *ast, ast_index_t node, semantic_t *sem);
+void check_return_expr(AST *ast, ast_index_t node, semantic_t *sem);
+void assignment_or_expression(AST *ast, ast_index_t node, semantic_t *sem);
+void check_function_call_args(AST *ast, ast_index_t node, const ht_item_t *fun, semantic_t *sem);
 bool check_types_compatibility(symtable_type_t expected_type, symtable_type_t actual_type);
+const ht_item_t *resolve_call(AST *ast, ast_index_t node, semantic_t *sem);
+ht_item_t *resolve_operand(AST *ast, ast_index_t node, uint32_t i, semantic_t *sem);
+void type_stack_push(semantic_t *sem, symtable_type_t type, symtable_var_type_t var_type);
+type_entry_t type_stack_pop(semantic_t *sem);
 
 /************ Main function of semantics analyzer ****************/
-void semantic_analysis(AST *ast){
-    ast->active = ast->root;
+void semantic_analysis(compiler_t *compiler){
+    semantic_t state = {0};
+    state.compiler = compiler;
+    state.type_stack.top = -1;
+
+    analyze_guarded(&state);
+    free_semantic(&state);
+}
+
+// Runs analysis, on error releases its state before the error is passed on
+void analyze_guarded(semantic_t *sem){
+    diag_t *diag = &sem->compiler->diag;
+    jmp_buf *outer = diag->jump;
+    jmp_buf jump;
+    if (setjmp(jump) != 0){
+        diag->jump = outer;
+        free_semantic(sem);
+        longjmp(*outer, 1);
+    }
+    diag->jump = &jump;
+    analyze_program(sem->compiler->ast, sem);
+    diag->jump = outer;
+}
+
+// Releases symtable and stacks of analysis
+void free_semantic(semantic_t *sem){
+    ht_free(&sem->table);
+    sym_stack_dispose(&sem->stack);
+    free(sem->type_stack.items);
+    sem->type_stack.items = NULL;
+    sem->type_stack.size = 0;
+}
+
+// Checks whole program
+void analyze_program(AST *ast, semantic_t *sem){
+    compiler_t *compiler = sem->compiler;
 
     // Creates and initializes symtable and stack
-    ht_table_t table;
-    ht_init(&table, 101);
-    sym_stack_t stack;
-    sym_stack_init(&stack);
+    ht_init(&sem->table, 128, &compiler->arena);
+    sym_stack_init(&sem->stack, &compiler->diag);
 
-    // Goes through the code for the first time and gets all the function declarations only
-    get_fun_declarations(ast, &table);
+    // Declares all functions from index built by parser, so calls can precede definitions
+    for (uint32_t i = 0; i < ast->function_count; i++){
+        save_fun_dec(ast, ast->functions[i], sem);
+    }
 
-    ht_item_t *main_fun = get_item(&stack, &table, "main");
+    ht_item_t *main_fun = get_item(&sem->table, intern_string(&compiler->intern, "main"));
 
     // Check for main function and correct definition of main
     if (main_fun == NULL){
-        fprintf(stderr, "Semantic error 3: Missing main function\n");
-        exit(3);
+        diag_raise(&sem->compiler->diag, 3, "Semantic error 3: Missing main function");
     }
     // Checks return type
     if (main_fun->return_type != sym_void_type){
-        fprintf(stderr, "Semantic error 4: Main cannot have a return type\n");
-        exit(4);
+        diag_raise(&sem->compiler->diag, 4, "Semantic error 4: Main cannot have a return type");
     }
     // Checks parameters
     if (main_fun->params != NULL){
-        fprintf(stderr, "Semantic error 4: Main cannot have parameters\n");
-        exit(4);
+        diag_raise(&sem->compiler->diag, 4, "Semantic error 4: Main cannot have parameters");
     }
 
     // Insert pseudovariable _ into table
     ht_item_t item;
-    item.name = "_";
+    item.id = INTERN_UNDERSCORE;
+    item.name = intern_text(&compiler->intern, INTERN_UNDERSCORE);
     item.type = sym_void_type;
     item.var_type = sym_var;
     item.used = true;
@@ -75,115 +143,38 @@ void semantic_analysis(AST *ast){
     item.input_parameters = -1;
     item.params = NULL;
     item.return_type = sym_void_type;
-    ht_insert(&table, &item);
+    ht_insert(&sem->table, &item);
 
-    // Gets declarations of the built-in functions
-    get_builtin_fun_declarations(&table);
+    // The only walk through the code
+    analyze_code(ast, ast->child[ast->root], sem);
 
-    // Second walk through
-    ast->active = ast->root;
-    analyze_code(ast, &table, &stack);
-
-    ht_delete_all(&table);
-}
-
-// Goes through whole ast but saves only function declarations
-void get_fun_declarations(AST *ast, ht_table_t *table){
-    while(ast->active != NULL && ast->active->token->type != eof_token){
-        
-        if (strcmp(ast->active->token->data, "pub") == 0){
-            save_fun_dec(ast, table);
-        }
-        else{
-            next_node(ast);
-        }
-    }
+    // Checks usage of global symbols
+    ht_delete_all(&sem->table);
 }
 
 // Saves function declaration to symtable
-void save_fun_dec(AST *ast, ht_table_t *table){
-    next_node(ast); // skip pub
-    next_node(ast); // skip fn
-
+void save_fun_dec(AST *ast, ast_index_t node, semantic_t *sem){
     ht_item_t item;
 
-    item.name = ast->active->token->data;
+    item.id = ast->payload[node].token->id;
+    item.name = ast->payload[node].token->data;
+
+    // Parameters are children of function before its block
     int args_cnt = 0;
-    symtable_type_t *arg_types_ptr = (symtable_type_t *)malloc((sizeof(symtable_type_t))*20);
-    if (arg_types_ptr == NULL){
-        fprintf(stderr, "Error allocating memory\n");
-        exit(99);
+    for (ast_index_t param = ast->child[node]; ast->type[param] == node_param; param = ast->next[param]){
+        args_cnt++;
     }
 
-    next_node(ast); // skip fun_name
-    next_node(ast); // skip (
-    
     // If there are no parameters
-    if (strcmp(ast->active->token->data, ")") == 0){
-        free(arg_types_ptr);
-        arg_types_ptr = NULL;
+    symtable_type_t *arg_types_ptr = NULL;
+    if (args_cnt > 0){
+        arg_types_ptr = (symtable_type_t *)arena_alloc(&sem->compiler->arena, sizeof(symtable_type_t) * args_cnt);
     }
 
     // Goes through all the parameters
-    while(strcmp(ast->active->token->data, ")") != 0){
-        next_node(ast); // skip arg_name
-        next_node(ast); // skip :
-
-        char *arg_type_name = ast->active->token->data;
-        symtable_type_t arg_type;
-
-        if (strcmp(arg_type_name, "i32") == 0){
-            arg_type = sym_int_type;
-        }
-        else if (strcmp(arg_type_name, "?i32") == 0){
-            arg_type = sym_nullable_int_type;
-        }
-        else if (strcmp(arg_type_name, "f64") == 0){
-            arg_type = sym_float_type;
-        }
-        else if (strcmp(arg_type_name, "?f64") == 0){
-            arg_type = sym_nullable_float_type;
-        }
-        else if (strcmp(arg_type_name, "[]u8") == 0){
-            arg_type = sym_string_type;
-        }
-        else{
-            arg_type = sym_nullable_string_type;
-        }
-
-        arg_types_ptr[args_cnt] = arg_type;
-        args_cnt++;
-        next_node(ast);
-        // Skip ',' because ',' can be also after last argument but doesnt have to
-        if (strcmp(ast->active->token->data, ",") == 0){
-            next_node(ast);
-        }
-    }
-
-    next_node(ast); // skip )
-    
-    // Checks return type and save it to symtable
-    symtable_type_t return_type;
-    if (strcmp(ast->active->token->data, "i32") == 0){
-        return_type = sym_int_type;
-    }
-    else if (strcmp(ast->active->token->data, "?i32") == 0){
-        return_type = sym_nullable_int_type;
-    }
-    else if (strcmp(ast->active->token->data, "f64") == 0){
-        return_type = sym_float_type;
-    }
-    else if (strcmp(ast->active->token->data, "?f64") == 0){
-        return_type = sym_nullable_float_type;
-    }
-    else if (strcmp(ast->active->token->data, "[]u8") == 0){
-        return_type = sym_string_type;
-    }
-    else if (strcmp(ast->active->token->data, "?[]u8") == 0){
-        return_type = sym_nullable_string_type;
-    }
-    else{
-        return_type = sym_void_type;
+    int idx = 0;
+    for (ast_index_t param = ast->child[node]; ast->type[param] == node_param; param = ast->next[param]){
+        arg_types_ptr[idx++] = kind_to_type(ast->data_type[param]);
     }
 
     // Sets the values
@@ -193,347 +184,202 @@ void save_fun_dec(AST *ast, ht_table_t *table){
     item.modified = true;
     item.input_parameters = args_cnt;
     item.params = arg_types_ptr;
-    item.return_type = return_type;
+    item.return_type = kind_to_type(ast->data_type[node]);
 
     // Inserts definition of function to symtable
-    ht_insert(table, &item);
-
-    next_node(ast); // skip return_type
-    next_node(ast); // skip {
+    ht_insert(&sem->table, &item);
 }
 
-// Generates built-in functions declarations
-void get_builtin_fun_declarations(ht_table_t *table){
-    ht_item_t item;
-
-    // Initialize item with default values same for all funs
-    item.type = sym_func_type;
-    item.var_type = sym_const;
-    item.used = true; // Built-in functions dont have to be used
-    item.modified = true;
-
-    // Set individual values that change
-    item.name = "ifj$readstr";
-    item.input_parameters = 0;
-    item.params = NULL;
-    item.return_type = sym_nullable_string_type;
-    ht_insert(table, &item);
-
-    item.name = "ifj$readi32";
-    item.return_type = sym_nullable_int_type;
-    ht_insert(table, &item);
-
-    item.name = "ifj$readf64";
-    item.return_type = sym_nullable_float_type;
-    ht_insert(table, &item);
-
-    item.name = "ifj$write";
-    item.input_parameters = 1;
-    item.params = malloc(sizeof(symtable_type_t) * 1);
-    if (item.params == NULL){
-        fprintf(stderr, "Error allocating memory\n");
-        exit(99);
-    }
-    item.params[0] = sym_void_type;     // sym_void_type indicating that it can take any type of argument
-    item.return_type = sym_void_type;
-    ht_insert(table, &item);
-
-    item.name = "ifj$i2f";
-    item.params = malloc(sizeof(symtable_type_t) * 1);
-    if (item.params == NULL){
-        fprintf(stderr, "Error allocating memory\n");
-        exit(99);
-    }
-    item.params[0] = sym_int_type;
-    item.return_type = sym_float_type;
-    ht_insert(table, &item);
-
-    item.name = "ifj$f2i";
-    item.params = malloc(sizeof(symtable_type_t) * 1);
-    if (item.params == NULL){
-        fprintf(stderr, "Error allocating memory\n");
-        exit(99);
+// Converts kind of type token to symtable type, void for anything else
+symtable_type_t kind_to_type(token_kind_t kind){
+    if (kind == kind_i32){
+        return sym_int_type;
     }
-    item.params[0] = sym_float_type;
-    item.return_type = sym_int_type;
-    ht_insert(table, &item);
-
-    item.name = "ifj$string";
-    item.params = malloc(sizeof(symtable_type_t) * 1);
-    if (item.params == NULL){
-        fprintf(stderr, "Error allocating memory\n");
-        exit(99);
+    else if (kind == kind_nullable_i32){
+        return sym_nullable_int_type;
     }
-    item.params[0] = sym_string_type;
-    item.return_type = sym_string_type;
-    ht_insert(table, &item);
-
-    item.name = "ifj$length";
-    item.params = malloc(sizeof(symtable_type_t) * 1);
-    if (item.params == NULL){
-        fprintf(stderr, "Error allocating memory\n");
-        exit(99);
+    else if (kind == kind_f64){
+        return sym_float_type;
     }
-    item.params[0] = sym_string_type;
-    item.return_type = sym_int_type;
-    ht_insert(table, &item);
-
-    item.name = "ifj$concat";
-    item.input_parameters = 2;
-    item.params = malloc(sizeof(symtable_type_t) * 2);
-    if (item.params == NULL){
-        fprintf(stderr, "Error allocating memory\n");
-        exit(99);
+    else if (kind == kind_nullable_f64){
+        return sym_nullable_float_type;
     }
-    item.params[0] = sym_string_type;
-    item.params[1] = sym_string_type;
-    item.return_type = sym_string_type;
-    ht_insert(table, &item);
-
-    item.name = "ifj$substring";
-    item.input_parameters = 3;
-    item.params = malloc(sizeof(symtable_type_t) * 3);
-    if (item.params == NULL){
-        fprintf(stderr, "Error allocating memory\n");
-        exit(99);
+    else if (kind == kind_string_type){
+        return sym_string_type;
     }
-    item.params[0] = sym_string_type;
-    item.params[1] = sym_int_type;
-    item.params[2] = sym_int_type;
-    item.return_type = sym_nullable_string_type;
-    ht_insert(table, &item);
-
-    item.name = "ifj$strcmp";
-    item.input_parameters = 2;
-    item.params = malloc(sizeof(symtable_type_t) * 2);
-    if (item.params == NULL){
-        fprintf(stderr, "Error allocating memory\n");
-        exit(99);
+    else if (kind == kind_nullable_string_type){
+        return sym_nullable_string_type;
     }
-    item.params[0] = sym_string_type;
-    item.params[1] = sym_string_type;
-    item.return_type = sym_int_type;
-    ht_insert(table, &item);
-
-    item.name = "ifj$ord";
-    item.params = malloc(sizeof(symtable_type_t) * 2);
-    if (item.params == NULL){
-        fprintf(stderr, "Error allocating memory\n");
-        exit(99);
-    }
-    item.params[0] = sym_string_type;
-    item.params[1] = sym_int_type;
-    item.return_type = sym_int_type;
-    ht_insert(table, &item);
-
-    item.name = "ifj$chr";
-    item.input_parameters = 1;
-    item.params = malloc(sizeof(symtable_type_t) * 1);
-    if (item.params == NULL){
-        fprintf(stderr, "Error allocating memory\n");
-        exit(99);
-    }
-    item.params[0] = sym_int_type;
-    item.return_type = sym_string_type;
-    ht_insert(table, &item);
+    return sym_void_type;
 }
 
 /***************************************************** MAIN CYCLE *************************************************************/
-// Calls appropriate function for semantic checks based on current code
-void analyze_code(AST *ast, ht_table_t *table, sym_stack_t *stack){
-    while(ast->active != NULL && ast->active->token->type != eof_token){
-        // For keeping track of scopes, so we can check missing return keyword
-        static int scope_cnt = 0;
-        static bool found_return = false;
-        static bool in_if = false;
-        static bool return_in_if = false;
-
-        // Depending on current code, chooses correct function
-        if (strcmp(ast->active->token->data, "var") == 0 || strcmp(ast->active->token->data, "const") == 0){
-            var_definition(ast, table, stack);
-        }
-        else if (strcmp(ast->active->token->data, "if") == 0 || strcmp(ast->active->token->data, "while") == 0){
-            scope_cnt++;
-            in_if = true;
-            new_scope_if_while(ast, table, stack);
-        }
-        else if (strcmp(ast->active->token->data, "else") == 0){
-            scope_cnt++;
-            in_if = false;
-            new_scope(stack, table);
-            next_node(ast); // skip else
-            next_node(ast); // skip {
-        }
-        else if (strcmp(ast->active->token->data, "pub") == 0){
-            scope_cnt++;
-            found_return = false;
-            new_scope_function(ast, table, stack);
-        }
-        else if (strcmp(ast->active->token->data, "}") == 0){
-            scope_cnt--;
-            // Updates variables for checking missing return keyword after exiting scope
-            if (in_if == false){
-                return_in_if = false;
-            }
-            if (scope_cnt == 1){
-                in_if = false;
-            }
-            // Checks for missing return when exiting scope of function
-            else if (scope_cnt == 0 && !found_return){
-                ht_item_t *fun = get_item(stack, table, current_function_name);
-
-                if (fun->return_type != sym_void_type){
-                    fprintf(stderr, "Semantic error 6: Missing return for non-void function\n");
-                    exit(6);
-                }
-            }
-            leave_scope(stack, table);
-            next_node(ast);
-        }
-        else if (strcmp(ast->active->token->data, "return") == 0){
+// Calls appropriate function for semantic checks for every statement in the list
+void analyze_code(AST *ast, ast_index_t node, semantic_t *sem){
+    for (; node != AST_NONE; node = ast->next[node]){
+        // Depending on current statement, chooses correct function
+        if (ast->type[node] == node_var_decl){
+            var_definition(ast, node, sem);
+        }
+        else if (ast->type[node] == node_if){
+            // children are condition, then block and else block
+            ast_index_t then_block = ast_child(ast, node, 1);
+            ast_index_t else_block = ast->next[then_block];
+
+            sem->scope_cnt++;
+            sem->in_if = true;
+            new_scope_if_while(ast, node, sem);
+            analyze_code(ast, ast->child[then_block], sem);
+            end_of_scope(sem);
+
+            // else branch
+            sem->scope_cnt++;
+            sem->in_if = false;
+            new_scope(&sem->stack);
+            analyze_code(ast, ast->child[else_block], sem);
+            end_of_scope(sem);
+        }
+        else if (ast->type[node] == node_while){
+            sem->scope_cnt++;
+            sem->in_if = true;
+            new_scope_if_while(ast, node, sem);
+            analyze_code(ast, ast->child[ast_child(ast, node, 1)], sem);
+            end_of_scope(sem);
+        }
+        else if (ast->type[node] == node_function){
+            sem->scope_cnt++;
+            sem->found_return = false;
+            new_scope_function(ast, node, sem);
+            analyze_code(ast, ast->child[ast_last_child(ast, node)], sem);
+            end_of_scope(sem);
+        }
+        else if (ast->type[node] == node_return){
             // Set to true only when finding return in the base function block or...
-            if (scope_cnt == 1){
-                found_return = true;
+            if (sem->scope_cnt == 1){
+                sem->found_return = true;
             }
-            else if (scope_cnt == 2 && in_if == true){
-                return_in_if = true;
+            else if (sem->scope_cnt == 2 && sem->in_if == true){
+                sem->return_in_if = true;
             }
             // or when in first scope in else while also has found return in if
-            else if (scope_cnt == 2 && in_if == false && return_in_if == true){
-                found_return = true;
+            else if (sem->scope_cnt == 2 && sem->in_if == false && sem->return_in_if == true){
+                sem->found_return = true;
             }
 
-            check_return_expr(ast, table, stack);
-        }
-        else if (ast->active->token->type == identifier_token){
-            assignment_or_expression(ast, table, stack);
+            check_return_expr(ast, node, sem);
         }
         else{
-            next_node(ast);
+            assignment_or_expression(ast, node, sem);
         }
     }
 }
 
+// Leaves scope at the end of block
+void end_of_scope(semantic_t *sem){
+    sem->scope_cnt--;
+    // Updates variables for checking missing return keyword after exiting scope
+    if (sem->in_if == false){
+        sem->return_in_if = false;
+    }
+    if (sem->scope_cnt == 1){
+        sem->in_if = false;
+    }
+    // Checks for missing return when exiting scope of function
+    else if (sem->scope_cnt == 0 && !sem->found_return){
+        if (sem->current_function->return_type != sym_void_type){
+            diag_raise(&sem->compiler->diag, 6, "Semantic error 6: Missing return for non-void function");
+        }
+    }
+    leave_scope(&sem->stack, &sem->table);
+}
+
 // Defining new variable and inserting it into symtable
-void var_definition(AST *ast, ht_table_t *table, sym_stack_t *stack){
+void var_definition(AST *ast, ast_index_t node, semantic_t *sem){
     symtable_var_type_t var_type;
     // Check if its var or const
-    if (strcmp(ast->active->token->data, "var") == 0) {
+    if (!ast->constant[node]) {
         var_type = sym_var;
     }
     else{
         var_type = sym_const;
     }
-    next_node(ast); // skip 'var/const'
-    
-    char *identifier = ast->active->token->data;
+
+    char *identifier = ast->payload[node].token->data;
+    int identifier_id = ast->payload[node].token->id;
     // Check for variable redefinition
-    ht_item_t *existing_item = get_item(stack, table, identifier);
+    ht_item_t *existing_item = get_item(&sem->table, identifier_id);
     if (existing_item != NULL){
-        fprintf(stderr, "Redefinition of variable %s\n", identifier);
-        exit(5);
+        diag_raise(&sem->compiler->diag, 5, "Redefinition of variable %s", identifier);
     }
 
     symtable_type_t type;
-    next_node(ast); // skip id
+    ast_index_t value = ast->child[node];
 
     // type is defined
-    if (strcmp(ast->active->token->data, ":") == 0){
-        next_node(ast); // skip :
-
-        if (strcmp(ast->active->token->data, "i32") == 0){
-            type = sym_int_type;
-        }
-        else if (strcmp(ast->active->token->data, "f64") == 0){
-            type = sym_float_type;
-        }
-        else if (strcmp(ast->active->token->data, "[]u8") == 0){
-            type = sym_string_type;
-        }
-        else if (strcmp(ast->active->token->data, "?i32") == 0){
-            type = sym_nullable_int_type;
-        }
-        else if (strcmp(ast->active->token->data, "?f64") == 0){
-            type = sym_nullable_float_type;
-        }
-        else {
+    if (ast->data_type[node] != kind_none){
+        type = kind_to_type(ast->data_type[node]);
+        // Anything else than listed types is taken as ?[]u8
+        if (type == sym_void_type){
             type = sym_nullable_string_type;
         }
-        next_node(ast); // skip type
-        next_node(ast); // skip =
 
         symtable_type_t res_type;
 
         // Its function call
-        if (strcmp(ast->active->next->token->data, "(") == 0){
+        if (ast->type[value] == node_call){
             // get return type of function to compare it later to defined return type
-            ht_item_t *fun = get_item(stack, table, ast->active->token->data);
-            if (fun == NULL){
-                fprintf(stderr, "Semantic error 3: Undefined function reference\n");
-                exit(3);
-            }
+            const ht_item_t *fun = resolve_call(ast, value, sem);
             res_type = fun->return_type;
-            fun->used = true;
 
             // check correct function call
-            check_function_call_args(ast, table, stack);
+            check_function_call_args(ast, value, fun, sem);
         }
         // its an expression
         else{
-            res_type = check_expression(ast, table, stack);
+            res_type = check_expression(ast, value, sem);
         }
 
         // expression result type (function call return type) is incompatible with defined type
         if (res_type != type){
             if(!check_types_compatibility(type, res_type)){
-                fprintf(stderr, "Semantic error 7: Type of expression (function call return type) is incompatible with defined type\n");
-                exit(7);
+                diag_raise(&sem->compiler->diag, 7, "Semantic error 7: Type of expression (function call return type) is incompatible with defined type");
             }
         }
     }
     // Have to derive the type from assignment expression
     else {
-        next_node(ast); // skip =
-        
         // Its function call
-        if (strcmp(ast->active->next->token->data, "(") == 0){
+        if (ast->type[value] == node_call){
 
             // check correct result_type
-            ht_item_t *fun = get_item(stack, table, ast->active->token->data);
-            if (fun == NULL){
-                fprintf(stderr, "Semantic error 3: Undefined function reference\n");
-                exit(3);
-            }
+            const ht_item_t *fun = resolve_call(ast, value, sem);
             type = fun->return_type;
-            fun->used = true;
 
             if (type == sym_void_type){
-                fprintf(stderr, "Semantic error 7: Incompatible types when assigning from function to variable %s\n", identifier);
-                exit(7);
+                diag_raise(&sem->compiler->diag, 7, "Semantic error 7: Incompatible types when assigning from function to variable %s", identifier);
             }
 
             // check correct function call
-            check_function_call_args(ast, table, stack);
+            check_function_call_args(ast, value, fun, sem);
         }
         // its an expression
         else{
 
-            if (ast->active->token->type == null_token) {
-                fprintf(stderr, "Semantic error 8: Type is not defined and cannot be derived from the expression\n");
-                exit(8);
+            if (ast_postfix(ast, value, 0)->type == null_token) {
+                diag_raise(&sem->compiler->diag, 8, "Semantic error 8: Type is not defined and cannot be derived from the expression");
             }
 
-            type = check_expression(ast, table, stack);
+            type = check_expression(ast, value, sem);
 
             if (type == sym_str_lit_type){
-                fprintf(stderr, "Semantic error 8: Invalid expressing type, cannot asign string to var: %s\n", identifier);
-                exit(8);
+                diag_raise(&sem->compiler->diag, 8, "Semantic error 8: Invalid expressing type, cannot asign string to var: %s", identifier);
             }
         }
     }
 
     // Creates item to carry parameters to insert function
     ht_item_t item;
+    item.id = identifier_id;
     item.name = identifier;
     item.type = type;
     item.var_type = var_type;
@@ -545,57 +391,48 @@ void var_definition(AST *ast, ht_table_t *table, sym_stack_t *stack){
     // inserts the variable into the sym_table
     if (var_type == sym_const){
         item.modified = true;
-        ht_insert(table, &item);
     }
     else{
         item.modified = false;
-        ht_insert(table, &item);
     }
+    ast->symbol[node] = declare_item(&sem->stack, &sem->table, &item);
 }
 
 
 // Checks if all the operands in expression are compatible and returns type of result of the expression
-symtable_type_t check_expression(AST *ast, ht_table_t *table, sym_stack_t *stack){
-    ht_item_t type_stack[100] = {0};
-    int stack_top = -1;
+symtable_type_t check_expression(AST *ast, ast_index_t node, semantic_t *sem){
+    // Stack is shared by all expressions, every expression leaves just its result in it
+    sem->type_stack.top = -1;
 
     symtable_type_t type = sym_void_type;
-    // Until it reaches end of expression
-    while (ast->active->token->type != semicolon_token && ast->active->token->type != bracket_token){
+    // Goes through operands and operators in postfix order
+    for (uint32_t i = 0; i < ast->payload[node].postfix.count; i++){
+        token_t *token = ast_postfix(ast, node, i);
+
         // Literals
-        if (ast->active->token->type == int_token){
-            type_stack[++stack_top].type = sym_int_type;
-            type_stack[stack_top].var_type = sym_literal;
+        if (token->type == int_token){
+            type_stack_push(sem, sym_int_type, sym_literal);
         }
-        else if (ast->active->token->type == float_token){
-            type_stack[++stack_top].type = sym_float_type;
-            type_stack[stack_top].var_type = sym_literal;
+        else if (token->type == float_token){
+            type_stack_push(sem, sym_float_type, sym_literal);
         }
-        else if (ast->active->token->type == string_token){
-            type_stack[++stack_top].type = sym_str_lit_type;
-            type_stack[stack_top].var_type = sym_literal;
+        else if (token->type == string_token){
+            type_stack_push(sem, sym_str_lit_type, sym_literal);
         }
-        else if (ast->active->token->type == null_token){
-            type_stack[++stack_top].type = sym_null_type;
-            type_stack[stack_top].var_type = sym_literal;
+        else if (token->type == null_token){
+            type_stack_push(sem, sym_null_type, sym_literal);
         }
         // variable
-        else if (ast->active->token->type == identifier_token){
+        else if (token->type == identifier_token){
             // check if the variable is defined
-            ht_item_t *var_entry = get_item(stack, table, ast->active->token->data);
-            if (var_entry == NULL){
-                fprintf(stderr, "Semantic error 3: Variable %s is not defined\n", ast->active->token->data);
-                exit(3);
-            }
-            var_entry->used = true;
+            ht_item_t *var_entry = resolve_operand(ast, node, i, sem);
 
-            type_stack[++stack_top].type = var_entry->type;
-            type_stack[stack_top].var_type = var_entry->var_type;
+            type_stack_push(sem, var_entry->type, var_entry->var_type);
         }
         // Binary arithmetic operations
-        else if (strcmp(ast->active->token->data, "+") == 0 || strcmp(ast->active->token->data, "-") == 0  || strcmp(ast->active->token->data, "*") == 0  || strcmp(ast->active->token->data, "/") == 0){
-            ht_item_t right = type_stack[stack_top--];
-            ht_item_t left = type_stack[stack_top--];
+        else if (token->kind == kind_plus || token->kind == kind_minus  || token->kind == kind_multiply  || token->kind == kind_divide){
+            type_entry_t right = type_stack_pop(sem);
+            type_entry_t left = type_stack_pop(sem);
 
             symtable_type_t right_type = right.type;
             symtable_type_t left_type = left.type;
@@ -614,12 +451,10 @@ symtable_type_t check_expression(AST *ast, ht_table_t *table, sym_stack_t *stack
                 if(left_type == right_type){
                     if (left_type == sym_nullable_int_type || left_type == sym_nullable_float_type ||
                         left_type == sym_nullable_string_type || left_type == sym_null_type){
-                        fprintf(stderr, "Semantic error 7: Cannot perform arithmetic operations with nullable types\n");
-                        exit(7);
+                        diag_raise(&sem->compiler->diag, 7, "Semantic error 7: Cannot perform arithmetic operations with nullable types");
                     }
                     else if (left_type == sym_string_type){
-                        fprintf(stderr, "Semantic error 7: Cannot perform arithmetic operations with []u8 types\n");
-                        exit(7);
+                        diag_raise(&sem->compiler->diag, 7, "Semantic error 7: Cannot perform arithmetic operations with []u8 types");
                     }
                     result_type = left_type;
                     result_var_type = left_var_type;
@@ -628,8 +463,7 @@ symtable_type_t check_expression(AST *ast, ht_table_t *table, sym_stack_t *stack
                 else if (left_type == sym_int_type && right_type == sym_float_type){
                     // integer is not const and so cannot be converted to float
                     if (left_var_type == sym_var){
-                        fprintf(stderr, "Semantic error 7: Cannot apply conversion to VAR variable a\n");
-                        exit(7);
+                        diag_raise(&sem->compiler->diag, 7, "Semantic error 7: Cannot apply conversion to VAR variable a");
                     }
                     result_type = sym_float_type;
                     result_var_type = sym_const;
@@ -638,15 +472,13 @@ symtable_type_t check_expression(AST *ast, ht_table_t *table, sym_stack_t *stack
                 else if(left_type == sym_float_type && right_type == sym_int_type) {
                     // integer is not const and so cannot be converted to float
                     if (right_var_type == sym_var){
-                        fprintf(stderr, "Semantic error 7: Cannot apply conversion to VAR variable b\n");
-                        exit(7);
+                        diag_raise(&sem->compiler->diag, 7, "Semantic error 7: Cannot apply conversion to VAR variable b");
                     }
                     result_type = sym_float_type;
                     result_var_type = sym_const;
                 }
                 else{
-                    fprintf(stderr, "Semantic error 7: Incompatible types between variables\n");
-                    exit(7);
+                    diag_raise(&sem->compiler->diag, 7, "Semantic error 7: Incompatible types between variables");
                 }
             }
             // One operand is a variable the other is literal constant
@@ -658,8 +490,7 @@ symtable_type_t check_expression(AST *ast, ht_table_t *table, sym_stack_t *stack
 
                 // variable is string
                 if (var_type == sym_string_type){
-                    fprintf(stderr, "Semantic error 7: Cannot perform arithmetic operations with strings\n");
-                    exit(7);
+                    diag_raise(&sem->compiler->diag, 7, "Semantic error 7: Cannot perform arithmetic operations with strings");
                 }
                 // same types
                 else if (var_type == literal_type){
@@ -672,14 +503,12 @@ symtable_type_t check_expression(AST *ast, ht_table_t *table, sym_stack_t *stack
                 // variable is int, literal is float
                 else if (var_type == sym_int_type && literal_type == sym_float_type){
                     if (type_of_variable == sym_var){    
-                        fprintf(stderr, "Semantic error 7: Cannot apply conversion to VAR variable c\n");
-                        exit(7);
+                        diag_raise(&sem->compiler->diag, 7, "Semantic error 7: Cannot apply conversion to VAR variable c");
                     }
                     result_type = sym_float_type;
                 }
                 else {
-                    fprintf(stderr, "Semantic error 7: Incompatible types between variable and literal\n");
-                    exit(7);
+                    diag_raise(&sem->compiler->diag, 7, "Semantic error 7: Incompatible types between variable and literal");
                 }
                 result_var_type = sym_const;
             }
@@ -694,25 +523,22 @@ symtable_type_t check_expression(AST *ast, ht_table_t *table, sym_stack_t *stack
                     result_type = sym_float_type;
                 }
                 else {
-                    fprintf(stderr, "Semantic error 7: Incompatible types between literals\n");
-                    exit(7);
+                    diag_raise(&sem->compiler->diag, 7, "Semantic error 7: Incompatible types between literals");
                 }
                 result_var_type = sym_literal;
             }
             else{
                 // Should not reach here, just in case...
-                fprintf(stderr, "Semantic error 7: Unknown operand kinds\n");
-                exit(7);
+                diag_raise(&sem->compiler->diag, 7, "Semantic error 7: Unknown operand kinds");
             }
-            type_stack[++stack_top].type = result_type;
-            type_stack[stack_top].var_type = result_var_type;
+            type_stack_push(sem, result_type, result_var_type);
         }
         // Relational operation
-        else if (strcmp(ast->active->token->data, "<") == 0 || strcmp(ast->active->token->data, ">") == 0 ||
-                strcmp(ast->active->token->data, "<=") == 0 || strcmp(ast->active->token->data, ">=") == 0){
+        else if (token->kind == kind_less || token->kind == kind_greater ||
+                token->kind == kind_less_equal || token->kind == kind_greater_equal){
 
-            ht_item_t right = type_stack[stack_top--];
-            ht_item_t left = type_stack[stack_top--];
+            type_entry_t right = type_stack_pop(sem);
+            type_entry_t left = type_stack_pop(sem);
 
             symtable_type_t right_type = right.type;
             symtable_type_t left_type = left.type;
@@ -730,32 +556,27 @@ symtable_type_t check_expression(AST *ast, ht_table_t *table, sym_stack_t *stack
                     // Both are nullable/null type
                     if (left_type == sym_nullable_int_type || left_type == sym_nullable_float_type ||
                         left_type == sym_nullable_string_type || left_type == sym_null_type){
-                        fprintf(stderr, "Semantic error 7: Cannot perform relational operations with nullable types\n");
-                        exit(7);
+                        diag_raise(&sem->compiler->diag, 7, "Semantic error 7: Cannot perform relational operations with nullable types");
                     }
                     // Both are []u8
                     else if (left_type == sym_string_type){
-                        fprintf(stderr, "Semantic error 7: Cannot perform relational operations with []u8 types\n");
-                        exit(7);
+                        diag_raise(&sem->compiler->diag, 7, "Semantic error 7: Cannot perform relational operations with []u8 types");
                     }
                 }
                 // One is int, other float
                 else if (left_type == sym_int_type && right_type == sym_float_type){
                     if (left_var_type == sym_var){
-                        fprintf(stderr, "Semantic error 7: Cannot apply conversion to VAR variable d\n");
-                        exit(7);
+                        diag_raise(&sem->compiler->diag, 7, "Semantic error 7: Cannot apply conversion to VAR variable d");
                     }
                 }
                 // One is int, other float
                 else if(left_type == sym_float_type && right_type == sym_int_type) {
                     if (right_var_type == sym_var){
-                        fprintf(stderr, "Semantic error 7: Cannot apply conversion to VAR variable e\n");
-                        exit(7);
+                        diag_raise(&sem->compiler->diag, 7, "Semantic error 7: Cannot apply conversion to VAR variable e");
                     }
                 }
                 else{
-                    fprintf(stderr, "Semantic error 7: Incompatible types between variables\n");
-                    exit(7);
+                    diag_raise(&sem->compiler->diag, 7, "Semantic error 7: Incompatible types between variables");
                 }
                 result_var_type = sym_literal;
             }
@@ -768,8 +589,7 @@ symtable_type_t check_expression(AST *ast, ht_table_t *table, sym_stack_t *stack
                 
                 // Variable is []u8
                 if (var_type == sym_string_type){
-                    fprintf(stderr, "Semantic error 7: Cannot perform arithmetic operations with strings\n");
-                    exit(7);
+                    diag_raise(&sem->compiler->diag, 7, "Semantic error 7: Cannot perform arithmetic operations with strings");
                 }
                 // same types
                 else if (var_type == literal_type){
@@ -782,13 +602,11 @@ symtable_type_t check_expression(AST *ast, ht_table_t *table, sym_stack_t *stack
                 // variable is integer, literal is float
                 else if (var_type == sym_int_type && literal_type == sym_float_type){
                     if (type_of_variable == sym_var){
-                        fprintf(stderr, "Semantic error 7: Cannot apply conversion to VAR variable f\n");
-                        exit(7);
+                        diag_raise(&sem->compiler->diag, 7, "Semantic error 7: Cannot apply conversion to VAR variable f");
                     }
                 }
                 else {
-                    fprintf(stderr, "Semantic error 7: Incompatible types between variable and literal\n");
-                    exit(7);
+                    diag_raise(&sem->compiler->diag, 7, "Semantic error 7: Incompatible types between variable and literal");
                 }
                 result_var_type = sym_literal;
             }
@@ -805,21 +623,19 @@ symtable_type_t check_expression(AST *ast, ht_table_t *table, sym_stack_t *stack
                     // Nothing needs to be done
                 }
                 else {
-                    fprintf(stderr, "Semantic error 7: Incompatible types between literals\n");
-                    exit(7);
+                    diag_raise(&sem->compiler->diag, 7, "Semantic error 7: Incompatible types between literals");
                 }
                 result_var_type = sym_literal;
             }
             result_type = sym_bool_type;
 
             // Push the result back onto the stack
-            type_stack[++stack_top].type = result_type;
-            type_stack[stack_top].var_type = result_var_type;
+            type_stack_push(sem, result_type, result_var_type);
         }
         // Relational operations using == or !=
-        else if (strcmp(ast->active->token->data, "==") == 0 || strcmp(ast->active->token->data, "!=") == 0){
-            ht_item_t right = type_stack[stack_top--];
-            ht_item_t left = type_stack[stack_top--];
+        else if (token->kind == kind_equal || token->kind == kind_not_equal){
+            type_entry_t right = type_stack_pop(sem);
+            type_entry_t left = type_stack_pop(sem);
 
             symtable_type_t right_type = right.type;
             symtable_type_t left_type = left.type;
@@ -834,22 +650,19 @@ symtable_type_t check_expression(AST *ast, ht_table_t *table, sym_stack_t *stack
             if(left_var_type != sym_literal && right_var_type != sym_literal){
                 if (left_type == right_type){
                     if (left_type == sym_nullable_string_type || left_type == sym_string_type){
-                        fprintf(stderr, "Semantic error 7: Cannot perform relational operations with []u8 types\n");
-                        exit(7);
+                        diag_raise(&sem->compiler->diag, 7, "Semantic error 7: Cannot perform relational operations with []u8 types");
                     }
                 }
                 // One is int, other float
                 else if (left_type == sym_int_type && right_type == sym_float_type){
                     if (left_var_type == sym_var){
-                        fprintf(stderr, "Semantic error 7: Cannot apply conversion to VAR variable g\n");
-                        exit(7);
+                        diag_raise(&sem->compiler->diag, 7, "Semantic error 7: Cannot apply conversion to VAR variable g");
                     }
                 }
                 // One is int, other float
                 else if(left_type == sym_float_type && right_type == sym_int_type) {
                     if (right_var_type == sym_var){
-                        fprintf(stderr, "Semantic error 7: Cannot apply conversion to VAR variable h\n");
-                        exit(7);
+                        diag_raise(&sem->compiler->diag, 7, "Semantic error 7: Cannot apply conversion to VAR variable h");
                     }
                 }
                 // Same types but one of them is nullable
@@ -858,8 +671,7 @@ symtable_type_t check_expression(AST *ast, ht_table_t *table, sym_stack_t *stack
                     // Correct and nothing needs to be done
                 }
                 else{
-                    fprintf(stderr, "Semantic error 7: Incompatible types between variables\n");
-                    exit(7);
+                    diag_raise(&sem->compiler->diag, 7, "Semantic error 7: Incompatible types between variables");
                 }
                 result_var_type = sym_var;
             }
@@ -872,8 +684,7 @@ symtable_type_t check_expression(AST *ast, ht_table_t *table, sym_stack_t *stack
                 
                 // Variable is []u8
                 if (var_type == sym_string_type){
-                    fprintf(stderr, "Semantic error 7: Cannot perform arithmetic operations with strings\n");
-                    exit(7);
+                    diag_raise(&sem->compiler->diag, 7, "Semantic error 7: Cannot perform arithmetic operations with strings");
                 }
                 // same types
                 else if (var_type == literal_type){
@@ -886,8 +697,7 @@ symtable_type_t check_expression(AST *ast, ht_table_t *table, sym_stack_t *stack
                 // variable is integer, literal is float
                 else if (var_type == sym_int_type && literal_type == sym_float_type){
                     if (type_of_variable == sym_var){
-                        fprintf(stderr, "Semantic error 7: Cannot apply conversion to VAR variable i\n");
-                        exit(7);
+                        diag_raise(&sem->compiler->diag, 7, "Semantic error 7: Cannot apply conversion to VAR variable i");
                     }
                 }
                 // Same types but one is including null
@@ -902,8 +712,7 @@ symtable_type_t check_expression(AST *ast, ht_table_t *table, sym_stack_t *stack
                     // Nothing needs to be done
                     }
                 else {
-                    fprintf(stderr, "Semantic error 7: Incompatible types between variable and literal\n");
-                    exit(7);
+                    diag_raise(&sem->compiler->diag, 7, "Semantic error 7: Incompatible types between variable and literal");
                 }
                 result_var_type = sym_var;
             }
@@ -923,80 +732,91 @@ symtable_type_t check_expression(AST *ast, ht_table_t *table, sym_stack_t *stack
                     // Nothing needs to be done
                 }
                 else {
-                    fprintf(stderr, "Semantic error 7: Incompatible types between literals\n");
-                    exit(7);
+                    diag_raise(&sem->compiler->diag, 7, "Semantic error 7: Incompatible types between literals");
                 }
                 result_var_type = sym_literal;
             }
             result_type = sym_bool_type;
 
             // Push the result back onto the stack
-            type_stack[++stack_top].type = result_type;
-            type_stack[stack_top].var_type = result_var_type;
+            type_stack_push(sem, result_type, result_var_type);
         }
-        next_node(ast);
     }
 
-    type = type_stack[stack_top].type;
+    type = type_stack_pop(sem).type;
     return type;
 }
 
+// Pushes type of operand or of result of operation
+void type_stack_push(semantic_t *sem, symtable_type_t type, symtable_var_type_t var_type){
+    if (sem->type_stack.top + 1 == sem->type_stack.size){
+        int size = sem->type_stack.size == 0 ? 64 : sem->type_stack.size * 2;
+        type_entry_t *items = (type_entry_t *)realloc(sem->type_stack.items, size * sizeof(type_entry_t));
+        if (items == NULL){
+            diag_raise(&sem->compiler->diag, 99, "Error allocating memory for type stack");
+        }
+        sem->type_stack.items = items;
+        sem->type_stack.size = size;
+    }
+    sem->type_stack.top++;
+    sem->type_stack.items[sem->type_stack.top].type = type;
+    sem->type_stack.items[sem->type_stack.top].var_type = var_type;
+}
+
+// Pops type of operand, expressions from parser always have enough operands
+type_entry_t type_stack_pop(semantic_t *sem){
+    return sem->type_stack.items[sem->type_stack.top--];
+}
+
 // Creates new scope for if/while and defines new variable if there is while/if extension
-void new_scope_if_while(AST *ast, ht_table_t *table, sym_stack_t *stack){
+void new_scope_if_while(AST *ast, ast_index_t node, semantic_t *sem){
 
-    new_scope(stack, table);
+    new_scope(&sem->stack);
 
-    next_node(ast); // skip while/if
-    next_node(ast); // skip (
+    ast_index_t condition = ast->child[node];
+    token_t *binding = ast->payload[node].token;
 
     // Doesnt have |extension|
-    if (strcmp(ast->active->next->next->token->data, "|") != 0){
+    if (binding == NULL){
         // Get expression result type
-        symtable_type_t type = check_expression(ast, table, stack);
-        // after expression, ast->active is ) || ;
+        symtable_type_t type = check_expression(ast, condition, sem);
 
         // If the result of the expression is not boolean
         if (type != sym_bool_type){
-            fprintf(stderr, "Semantic error 7: Condition result is not of type boolean\n");
-            exit(7);
+            diag_raise(&sem->compiler->diag, 7, "Semantic error 7: Condition result is not of type boolean");
         }
-
-        next_node(ast); // skip )
-        next_node(ast); // skip {
-
     }
     // Does have |extension|
     else{
-        ht_item_t *item = get_item(stack, table, ast->active->token->data);
-        if (item == NULL){
-            fprintf(stderr, "Semantic error 3: Undefined variable in condition\n");
-            exit(3);
+        symtable_type_t type;
+
+        // Condition is a variable
+        if (ast->payload[condition].postfix.count == 1){
+            ht_item_t *item = resolve_operand(ast, condition, 0, sem);
+            type = item->type;
+        }
+        // Result of any other expression cannot include null
+        else{
+            type = check_expression(ast, condition, sem);
         }
 
-        item->used = true;
         // Checks if variable in condition is of type including null
-        symtable_type_t type = item->type;
         if (type != sym_nullable_int_type && type != sym_nullable_float_type && type != sym_nullable_string_type) {
-            fprintf(stderr, "Semantic error 7: Variable is not of type including null\n");
-            exit(7);
+            diag_raise(&sem->compiler->diag, 7, "Semantic error 7: Variable is not of type including null");
         }
         // Convert to type not including null
         type--;
 
-        next_node(ast); // skip expr
-        next_node(ast); // skip )
-        next_node(ast); // skip |
-
-        ht_item_t *existing_item = get_item(stack, table, ast->active->token->data);
+        ht_item_t *existing_item = get_item(&sem->table, binding->id);
         // Check for variable redefinition
         if (existing_item != NULL){
-            fprintf(stderr, "Redefinition of variable %s\n", ast->active->token->data);
-            exit(5);
+            diag_raise(&sem->compiler->diag, 5, "Redefinition of variable %s", binding->data);
         }
 
         // Inserts new variable into the symtable
         ht_item_t new_item;
-        new_item.name = ast->active->token->data;
+        new_item.id = binding->id;
+        new_item.name = binding->data;
         new_item.type = type;
         new_item.var_type = sym_var;
         new_item.used = false;
@@ -1004,65 +824,38 @@ void new_scope_if_while(AST *ast, ht_table_t *table, sym_stack_t *stack){
         new_item.input_parameters = -1;
         new_item.params = NULL;
         new_item.return_type = sym_void_type;
-        ht_insert(table, &new_item);
-        
-        next_node(ast); // skip id_without_null
-        next_node(ast); // skip |
-        next_node(ast); // skip {
+        ast->symbol[node] = declare_item(&sem->stack, &sem->table, &new_item);
     }
 }
 
 // Creates new scope for function and define fun arguments in it
-void new_scope_function(AST *ast, ht_table_t *table, sym_stack_t *stack){
-    next_node(ast); // skip pub
-    next_node(ast); // skip fn
-    
-    current_function_name = ast->active->token->data; // saving the name of the current function we are in
-    next_node(ast); // skip fun_name
-    next_node(ast); // skip (
+void new_scope_function(AST *ast, ast_index_t node, semantic_t *sem){
+    // saving the function we are in, declared before the walk
+    sem->current_function = get_item(&sem->table, ast->payload[node].token->id);
+    ast->symbol[node] = sem->current_function;
 
-    new_scope(stack, table);
+    new_scope(&sem->stack);
 
     // Loop through all the arguments
-    while(strcmp(ast->active->token->data, ")") != 0){
-        char *arg_name = ast->active->token->data;
+    for (ast_index_t param = ast->child[node]; ast->type[param] == node_param; param = ast->next[param]){
+        char *arg_name = ast->payload[param].token->data;
+        int arg_id = ast->payload[param].token->id;
 
         // Check for variable redefinition
-        ht_item_t *existing_item = get_item(stack, table, arg_name);
+        ht_item_t *existing_item = get_item(&sem->table, arg_id);
         if (existing_item != NULL){
-            fprintf(stderr, "Redefinition of variable %s\n", arg_name);
-            exit(5);
+            diag_raise(&sem->compiler->diag, 5, "Redefinition of variable %s", arg_name);
         }
 
-        next_node(ast); // skip arg_name
-        next_node(ast); // skip :
-
-        char *arg_type_name = ast->active->token->data;
-        symtable_type_t arg_type;
-
-        if (strcmp(arg_type_name, "i32") == 0){
-            arg_type = sym_int_type;
-        }
-        else if (strcmp(arg_type_name, "?i32") == 0){
-            arg_type = sym_nullable_int_type;
-        }
-        else if (strcmp(arg_type_name, "f64") == 0){
-            arg_type = sym_float_type;
-        }
-        else if (strcmp(arg_type_name, "?f64") == 0){
-            arg_type = sym_nullable_float_type;
-        }
-        else if (strcmp(arg_type_name, "[]u8") == 0){
-            arg_type = sym_string_type;
-        }
-        else{
+        symtable_type_t arg_type = kind_to_type(ast->data_type[param]);
+        // Anything else than listed types is taken as ?[]u8
+        if (arg_type == sym_void_type){
             arg_type = sym_nullable_string_type;
         }
 
-        next_node(ast); // skip type
-
         // Inserts new variable to the symtable
         ht_item_t item;
+        item.id = arg_id;
         item.name = arg_name;
         item.type = arg_type;
         item.var_type = sym_const;
@@ -1071,139 +864,104 @@ void new_scope_function(AST *ast, ht_table_t *table, sym_stack_t *stack){
         item.input_parameters = -1;
         item.params = NULL;
         item.return_type = sym_void_type;
-        ht_insert(table, &item);
-
-        // Skip ',', because ',' can be also after last argument but doesnt have to
-        if (strcmp(ast->active->token->data, ",") == 0){
-            next_node(ast);
-        }
+        ast->symbol[param] = declare_item(&sem->stack, &sem->table, &item);
     }
-
-    next_node(ast); // skip )
-    next_node(ast); // skip return_type
-    next_node(ast); // skip {
 }
 
 // Calls check_expression and compares the type to the type the expression is supposed to return
-void check_return_expr(AST *ast, ht_table_t *table, sym_stack_t *stack){
-    next_node(ast); // skip return
-    
-    ht_item_t *fun_entry = get_item(stack, table, current_function_name);
-    symtable_type_t current_function_type = fun_entry->return_type;
+void check_return_expr(AST *ast, ast_index_t node, semantic_t *sem){
+    symtable_type_t current_function_type = sem->current_function->return_type;
 
     // Check for "return;"
-    if (ast->active->token->type == semicolon_token){
+    if (ast->child[node] == AST_NONE){
         if(current_function_type != sym_void_type){
-            fprintf(stderr, "Semantic error 6: Missing expression in function return\n");
-            exit(6);
+            diag_raise(&sem->compiler->diag, 6, "Semantic error 6: Missing expression in function return");
         }
-
-        next_node(ast); // skip ;
         return;
     }
 
     // Check if function isn't void type
     if (current_function_type == sym_void_type){
-        fprintf(stderr, "Semantic error 6: Returning expression in a function with void return type\n");
-        exit(6);
+        diag_raise(&sem->compiler->diag, 6, "Semantic error 6: Returning expression in a function with void return type");
     }
 
     // Check for compatible expression and function return types
-    symtable_type_t expr_type = check_expression(ast, table, stack);
+    symtable_type_t expr_type = check_expression(ast, ast->child[node], sem);
 
     if (expr_type != current_function_type){
         if (!check_types_compatibility(current_function_type, expr_type)){
-            fprintf(stderr, "Semantic error 4: Function '%s' return type mismatch.\n", current_function_name);
-            exit(4);
+            diag_raise(&sem->compiler->diag, 4, "Semantic error 4: Function '%s' return type mismatch.", sem->current_function->name);
         }
     }
-    
-    next_node(ast); // skip ;
 }
 
 // Checks correct assignment or function call without assignment
-void assignment_or_expression(AST *ast, ht_table_t *table, sym_stack_t *stack){
+void assignment_or_expression(AST *ast, ast_index_t node, semantic_t *sem){
     // Its a function call without assignment
-    if (strcmp(ast->active->next->token->data, "(") == 0){
+    if (ast->type[node] == node_call){
         // Checks if function is defined
-        char *fun_name = ast->active->token->data;
-        ht_item_t *fun = get_item(stack, table, fun_name);
-        if (fun == NULL){
-            fprintf(stderr, "Semantic error 3: Undefined function reference\n");
-            exit(3);
-        }
-        fun->used = true;
+        const ht_item_t *fun = resolve_call(ast, node, sem);
 
         // Check if function is void type or illegal discarding of return type
         if (fun->return_type != sym_void_type){
-            fprintf(stderr, "Semantic error 4: Illegal discarding of function return value\n");
-            exit(4);
+            diag_raise(&sem->compiler->diag, 4, "Semantic error 4: Illegal discarding of function return value");
         }
-        check_function_call_args(ast, table, stack);
+        check_function_call_args(ast, node, fun, sem);
     }
     // Its an assignment
     else{
-        char *var_name = ast->active->token->data;
-        ht_item_t *var = get_item(stack, table, var_name);
+        char *var_name = ast->payload[node].token->data;
+        int var_id = ast->payload[node].token->id;
+        ht_item_t *var = get_item(&sem->table, var_id);
+        if (var == NULL){
+            diag_raise(&sem->compiler->diag, 3, "Semantic error 3: Variable %s is not defined", var_name);
+        }
+        ast->symbol[node] = var;
         var->used = true;
         var->modified = true;
         
         // Check if modifying var or const variable 
         if (var->var_type == sym_const){
-            fprintf(stderr, "Semantic error 5: Cannot modify variable %s of type const\n", var_name);
-            exit(5);
+            diag_raise(&sem->compiler->diag, 5, "Semantic error 5: Cannot modify variable %s of type const", var_name);
         }
 
         symtable_type_t var_type = var->type;
-
-        next_node(ast); // skip var_name
-        next_node(ast); // skip =
+        ast_index_t value = ast->child[node];
 
         // Its a function assignment
-        if (strcmp(ast->active->next->token->data, "(") == 0){
+        if (ast->type[value] == node_call){
             // Checks if function is defined
-            char *fun_name = ast->active->token->data;
-            ht_item_t *fun = get_item(stack, table, fun_name);
-            if (fun == NULL){
-                fprintf(stderr, "Semantic error 3: Undefined function reference '%s'\n", fun_name);
-                exit(3);
-            }
-
-            fun->used = true;
+            const ht_item_t *fun = resolve_call(ast, value, sem);
 
             symtable_type_t fun_ret_type = fun->return_type;
 
             // Checks if function has a return type
             if (fun_ret_type == sym_void_type){
-                fprintf(stderr, "Semantic erorr 7: Assignment from function '%s' that doesnt return anything\n", fun->name);
-                exit(7);
+                diag_raise(&sem->compiler->diag, 7, "Semantic erorr 7: Assignment from function '%s' that doesnt return anything", fun->name);
             }
             // Checks if function return type is compatible with type of variable assigning to
-            else if (fun_ret_type != var_type && strcmp(var_name, "_") != 0){
+            else if (fun_ret_type != var_type && var_id != INTERN_UNDERSCORE){
                 if (!check_types_compatibility(var_type, fun_ret_type)){
-                    fprintf(stderr, "Semantic erorr 7: Incompatible types when assigning from function\n");
-                    exit(7);
+                    diag_raise(&sem->compiler->diag, 7, "Semantic erorr 7: Incompatible types when assigning from function");
                 }
             }
 
-            check_function_call_args(ast, table, stack);
+            check_function_call_args(ast, value, fun, sem);
 
         }
         // Its an expression assignment
         else{
-            symtable_type_t expr_res_type = check_expression(ast, table, stack);
+            symtable_type_t expr_res_type = check_expression(ast, value, sem);
 
             // Check for assigning string directly to variable
             if (expr_res_type == sym_str_lit_type){
-                fprintf(stderr, "Semantic error 7: Cannot assign string directly to variable\n");
-                exit(7);
+                diag_raise(&sem->compiler->diag, 7, "Semantic error 7: Cannot assign string directly to variable");
             }
 
             // Checks if expression result type is compatible with type of variable assigning to
-            if (var_type != expr_res_type && strcmp(var_name, "_") != 0){
+            if (var_type != expr_res_type && var_id != INTERN_UNDERSCORE){
                 if (!check_types_compatibility(var_type, expr_res_type)){
-                    fprintf(stderr, "Semantic error 7: Incompatible assignment type\n");
-                    exit(7);
+                    diag_raise(&sem->compiler->diag, 7, "Semantic error 7: Incompatible assignment type");
                 }
             }
         }
@@ -1211,69 +969,85 @@ void assignment_or_expression(AST *ast, ht_table_t *table, sym_stack_t *stack){
 }
 
 // Checks if given function is called with correct types of arguments
-// ast->active == function_name
-void check_function_call_args(AST *ast, ht_table_t *table, sym_stack_t *stack){
-    ht_item_t *fun_entry = get_item(stack, table, ast->active->token->data);
-    // Function reference is always already checked before calling this
-    int expected_params = fun_entry->input_parameters;
-    symtable_type_t *expected_types = fun_entry->params;
-    
-    next_node(ast); // skip function name
-    next_node(ast); // skip '(
+void check_function_call_args(AST *ast, ast_index_t node, const ht_item_t *fun, semantic_t *sem){
+    int expected_params = fun->input_parameters;
+    const symtable_type_t *expected_types = fun->params;
     
     int idx = 0;
-    // Loop through all the arguments
-    while (strcmp(ast->active->token->data, ")") != 0){
-        symtable_type_t arg_type;
+    // Loop through all the arguments, every argument is a single term
+    for (ast_index_t arg = ast->child[node]; arg != AST_NONE; arg = ast->next[arg]){
+        token_t *token = ast_postfix(ast, arg, 0);
+        symtable_type_t arg_type = sym_void_type;
 
         // When finding variable, checks if its defined
-        if (ast->active->token->type == identifier_token){
-            ht_item_t *var_entry = get_item(stack, table, ast->active->token->data);
-            if (var_entry == NULL){
-                fprintf(stderr, "Semantic error 3: Variable '%s' not defined\n", ast->active->token->data);
-                exit(3);
-            }
-            var_entry->used = true;
+        if (token->type == identifier_token){
+            ht_item_t *var_entry = resolve_operand(ast, arg, 0, sem);
             arg_type = var_entry->type;
         }
-        else if (ast->active->token->type == int_token){
+        else if (token->type == int_token){
             arg_type = sym_int_type;
         }
-        else if (ast->active->token->type == float_token){
+        else if (token->type == float_token){
             arg_type = sym_float_type;
         }
-        else if (ast->active->token->type == string_token){
+        else if (token->type == string_token){
             arg_type = sym_string_type;
         }
-        else if (ast->active->token->type == null_token){
+        else if (token->type == null_token){
             arg_type = sym_null_type;
         }
 
-        symtable_type_t expected_type = expected_types[idx];
+        // More arguments than parameters
+        if (idx >= expected_params){
+            diag_raise(&sem->compiler->diag, 4, "Semantic error 4: Invalid number of arguments");
+        }
 
+        symtable_type_t expected_type = expected_types[idx];
 
         // Check for correct argument type
         if (arg_type != expected_type && expected_type != sym_void_type){
             if (!check_types_compatibility(expected_type, arg_type)){
-                fprintf(stderr, "Semantic error 4: Invalid argument type\n");
-                exit(4);
+                diag_raise(&sem->compiler->diag, 4, "Semantic error 4: Invalid argument type");
             }
         }
 
         idx++;
-        next_node(ast);
-        
-        // skip ','
-        if (strcmp(ast->active->token->data, ",") == 0){
-            next_node(ast);
-        }
     }
     // Check for correct number of arguments
     if (idx != expected_params){
-        fprintf(stderr, "Semantic error 4: Invalid number of arguments\n");
-        exit(4);
+        diag_raise(&sem->compiler->diag, 4, "Semantic error 4: Invalid number of arguments");
+    }
+}
+
+// Finds signature of called function, symbol of user function is saved to the call node
+const ht_item_t *resolve_call(AST *ast, ast_index_t node, semantic_t *sem){
+    token_t *name = ast->payload[node].token;
+
+    // Built-in functions are not in symtable, their read-only signatures are not saved to the AST
+    const ht_item_t *builtin = builtin_function(name->id);
+    if (builtin != NULL){
+        return builtin;
+    }
+
+    ht_item_t *fun = get_item(&sem->table, name->id);
+    if (fun == NULL){
+        diag_raise(&sem->compiler->diag, 3, "Semantic error 3: Undefined function reference '%s'", name->data);
+    }
+    fun->used = true;
+    ast->symbol[node] = fun;
+    return fun;
+}
+
+// Finds symbol of variable that is i-th token of expression and saves it next to the token
+ht_item_t *resolve_operand(AST *ast, ast_index_t node, uint32_t i, semantic_t *sem){
+    token_t *token = ast_postfix(ast, node, i);
+    ht_item_t *var = get_item(&sem->table, token->id);
+    if (var == NULL){
+        diag_raise(&sem->compiler->diag, 3, "Semantic error 3: Variable %s is not defined", token->data);
     }
-    next_node(ast); // skip ')'
+    var->used = true;
+    ast->postfix_symbol[ast->payload[node].postfix.start + i] = var;
+    return var;
 }
 
 // For checking compatibility with nullable types
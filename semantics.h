@@ -10,9 +10,10 @@
 #define SEMANTICS_H
 
 #include <stdbool.h>
+#include "compiler.h"
 
 
 // Main function of semantics analyzer
-void semantic_analysis(AST *ast);
+void semantic_analysis(compiler_t *compiler);
 
 #endif
\ No newline at end of file
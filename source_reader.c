@@ -0,0 +1,130 @@
+/*
+* Project: Implementacia prekladaca imperativneho jazyka IFJ2024
+*
+* @author: Rebeka Tydorova <xtydor01>
+* @author: Jakub Hrdlicka <xhrdli18>
+*
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "source_reader.h"
+
+// Size of one chunk read from pipe
+#define SOURCE_CHUNK_SIZE 65536
+
+//read whole file descriptor in large chunks (pipes, terminals)
+void source_read_chunks(source_reader_t *source, int fd){
+    size_t capacity = SOURCE_CHUNK_SIZE;
+    char *buffer = (char *)malloc(capacity);
+    if (buffer == NULL){
+        fprintf(stderr, "Failed to malloc space for source.\n");
+        exit(99);
+    }
+
+    size_t length = 0;
+    while (true){
+        if (length == capacity){
+            capacity *= 2;
+            buffer = (char *)realloc(buffer, capacity);
+            if (buffer == NULL){
+                fprintf(stderr, "Failed to realloc space for source.\n");
+                exit(99);
+            }
+        }
+        ssize_t count = read(fd, buffer + length, capacity - length);
+        if (count < 0){
+            fprintf(stderr, "Failed to read source.\n");
+            exit(99);
+        }
+        if (count == 0){
+            break;
+        }
+        length += count;
+    }
+
+    source->data = buffer;
+    source->length = length;
+    source->mapped = false;
+}
+
+//load source, regular files are mmaped, anything else is read in chunks
+void source_open(source_reader_t *source, const char *path){
+    int fd = STDIN_FILENO;
+    if (path != NULL){
+        fd = open(path, O_RDONLY);
+        if (fd < 0){
+            fprintf(stderr, "Failed to open source file %s.\n", path);
+            exit(99);
+        }
+    }
+
+    source->data = NULL;
+    source->length = 0;
+    source->pos = 0;
+    source->mapped = false;
+    source->borrowed = false;
+
+    struct stat info;
+    if (fstat(fd, &info) == 0 && S_ISREG(info.st_mode) && info.st_size > 0){
+        void *data = mmap(NULL, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data != MAP_FAILED){
+            source->data = (const char *)data;
+            source->length = info.st_size;
+            source->mapped = true;
+        }
+    }
+
+    if (!source->mapped){
+        source_read_chunks(source, fd);
+    }
+
+    if (path != NULL){
+        close(fd);
+    }
+}
+
+//use source loaded by caller
+void source_borrow(source_reader_t *source, const char *data, size_t length){
+    source->data = data;
+    source->length = length;
+    source->pos = 0;
+    source->mapped = false;
+    source->borrowed = true;
+}
+
+//return next char of source
+int source_getc(source_reader_t *source){
+    if (source->pos >= source->length){
+        // cursor moves even past the end, so pushback of EOF works as with ungetc
+        source->pos++;
+        return EOF;
+    }
+    return (unsigned char)source->data[source->pos++];
+}
+
+//push last read char back
+void source_ungetc(source_reader_t *source){
+    if (source->pos > 0){
+        source->pos--;
+    }
+}
+
+//release loaded source
+void source_close(source_reader_t *source){
+    if (source->mapped){
+        munmap((void *)source->data, source->length);
+    }
+    else if (!source->borrowed){
+        free((void *)source->data);
+    }
+    source->data = NULL;
+    source->length = 0;
+    source->pos = 0;
+    source->mapped = false;
+    source->borrowed = false;
+}
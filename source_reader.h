@@ -0,0 +1,38 @@
+/*
+* Project: Implementacia prekladaca imperativneho jazyka IFJ2024
+*
+* @author: Rebeka Tydorova <xtydor01>
+* @author: Jakub Hrdlicka <xhrdli18>
+*
+*/
+#ifndef SOURCE_READER_H
+#define SOURCE_READER_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+// Whole source loaded into memory, lexer walks it with a cursor
+typedef struct source_reader {
+    const char *data;   // start of the source
+    size_t length;      // number of bytes in source
+    size_t pos;         // cursor, index of next char to read
+    bool mapped;        // data is mmaped, otherwise malloced
+    bool borrowed;      // data belongs to caller and is not released
+} source_reader_t;
+
+// Load source from file on given path, or from stdin when path is NULL
+void source_open(source_reader_t *source, const char *path);
+
+// Use source already loaded in memory by caller, it is not copied
+void source_borrow(source_reader_t *source, const char *data, size_t length);
+
+// Return next char of source and move cursor, EOF at the end of source
+int source_getc(source_reader_t *source);
+
+// Push last read char back (one char pushback)
+void source_ungetc(source_reader_t *source);
+
+// Release loaded source
+void source_close(source_reader_t *source);
+
+#endif
@@ -12,21 +12,21 @@
 #include <string.h>
 #include "str_buffer.h"
 
-str_buffer_t *create_str_buffer() {
+str_buffer_t *create_str_buffer(diag_t *diag) {
 
     str_buffer_t* buffer = (str_buffer_t *)malloc(sizeof(struct str_buffer));
     if (buffer == NULL) {
-        fprintf(stderr, "Failed to malloc space for buffer.\n");
-        exit(99);
+        diag_raise(diag, 99, "Failed to malloc space for buffer.");
     }
 
+    buffer->diag = diag;
     buffer->size = 0;
     buffer->capacity = 30;
     size_t malcap = sizeof(char) * buffer->capacity;
     buffer->string = (char *)malloc(malcap);
     if (buffer->string == NULL){
-        fprintf(stderr, "Failed to malloc space for buffer.\n");
-        exit(99);
+        free(buffer);
+        diag_raise(diag, 99, "Failed to malloc space for buffer.");
     }
 
     buffer->string[0] = '\0';
@@ -39,8 +39,7 @@ void append_to_str_buffer(str_buffer_t* buffer, char c) {
         buffer->capacity *= 2;
         buffer->string = (char*)realloc(buffer->string, sizeof(char) * buffer->capacity);
         if (buffer->string == NULL) {
-            fprintf(stderr, "Failed to realloc space for buffer.\n");
-            exit(99);
+            diag_raise(buffer->diag, 99, "Failed to realloc space for buffer.");
         }
     }
 
@@ -48,4 +47,24 @@ void append_to_str_buffer(str_buffer_t* buffer, char c) {
     buffer->size ++;
 
     buffer->string[buffer->size] = '\0';
+}
+
+void clear_str_buffer(str_buffer_t* buffer) {
+    buffer->size = 0;
+    buffer->string[0] = '\0';
+}
+
+char* copy_str_buffer(str_buffer_t* buffer) {
+    char* copy = (char *)malloc(sizeof(char) * (buffer->size + 1));
+    if (copy == NULL) {
+        diag_raise(buffer->diag, 99, "Failed to malloc space for buffer.");
+    }
+
+    memcpy(copy, buffer->string, buffer->size + 1);
+    return copy;
+}
+
+void free_str_buffer(str_buffer_t* buffer) {
+    free(buffer->string);
+    free(buffer);
 }
\ No newline at end of file
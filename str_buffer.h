@@ -9,15 +9,20 @@
 #define STR_BUFFER_H
 
 #include <stdlib.h>
+#include "diag.h"
 
 typedef struct str_buffer {
     char* string;
     size_t size;
     size_t capacity;
+    diag_t *diag;
 } str_buffer_t;
 
-str_buffer_t* create_str_buffer();
+str_buffer_t* create_str_buffer(diag_t *diag);
 void append_to_str_buffer(str_buffer_t* buffer, char c);
+void clear_str_buffer(str_buffer_t* buffer);
+char* copy_str_buffer(str_buffer_t* buffer);
+void free_str_buffer(str_buffer_t* buffer);
 
 
 #endif
\ No newline at end of file
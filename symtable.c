@@ -12,43 +12,36 @@
 #include "symtable_stack.h"
 
 
-// Enter new scope
-void new_scope(sym_stack_t *stack, ht_table_t *table){
-    ht_table_t *temp = malloc(sizeof(ht_table_t));
-    if(temp == NULL){
-        fprintf(stderr, "Error: malloc failed\n");
-        exit(99);
-    }
-    ht_copy(table, temp);
-    sym_stack_push(stack, temp);
+// One table holds symbols of all open scopes,
+// the stack remembers which symbols were declared in which scope
 
-    ht_table_t new_table;
-    ht_init(&new_table, 101);
-    *table = new_table;
+// Enter new scope
+void new_scope(sym_stack_t *stack){
+    sym_stack_push(stack, SYM_SCOPE_MARK);
 }
 
 
 // Leave current scope
 void leave_scope(sym_stack_t *stack, ht_table_t *table){
-    ht_table_t *temp = sym_stack_top(stack);
-    if(temp != NULL){
-        ht_delete_all(table);
-        *table = *temp;
+    // Removes symbols declared since the scope mark
+    while(!sym_stack_empty(stack) && sym_stack_top(stack) != SYM_SCOPE_MARK){
+        int id = sym_stack_top(stack);
+        ht_check_usage(table, ht_search(table, id));
+        ht_delete(table, id);
+        sym_stack_pop(stack);
     }
     sym_stack_pop(stack);
 }
 
 
+// Declare item in current scope
+ht_item_t *declare_item(sym_stack_t *stack, ht_table_t *table, ht_item_t *item){
+    sym_stack_push(stack, item->id);
+    return ht_insert(table, item);
+}
+
+
 // Get item from symtable
-ht_item_t *get_item(sym_stack_t *stack, ht_table_t *table, char *name){
-    ht_item_t *item = ht_search(table, name);
-    if(item == NULL){
-        for(int i = stack->top_index; i >= 0; i--){
-            item = ht_search(stack->table[i], name);
-            if(item != NULL){
-                break;
-            }
-        }
-    }
-    return item;
+ht_item_t *get_item(ht_table_t *table, int id){
+    return ht_search(table, id);
 }
\ No newline at end of file
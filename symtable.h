@@ -13,13 +13,17 @@
 
 
 // Enter new scope
-void new_scope(sym_stack_t *stack, ht_table_t *table);
+void new_scope(sym_stack_t *stack);
 
-// Leave current scope
+// Leave current scope, removes symbols declared in it
+// Also checking unused variable semantic error
 void leave_scope(sym_stack_t *stack, ht_table_t *table);
 
+// Declare item in current scope, returns the declared item
+ht_item_t *declare_item(sym_stack_t *stack, ht_table_t *table, ht_item_t *item);
+
 // Get item from symtable
-ht_item_t *get_item(sym_stack_t *stack, ht_table_t *table, char *name);
+ht_item_t *get_item(ht_table_t *table, int id);
 
 
 #endif
\ No newline at end of file
@@ -12,12 +12,12 @@
 
 
 // Inicialize stack
-void sym_stack_init(sym_stack_t *stack){
+void sym_stack_init(sym_stack_t *stack, diag_t *diag){
+    stack->diag = diag;
     stack->size = 50;
-    stack->table = (ht_table_t **)malloc(sizeof(ht_table_t *) * stack->size);
-    if(stack->table == NULL){
-        fprintf(stderr, "Error: malloc failed\n");
-        exit(99);
+    stack->ids = (int *)malloc(sizeof(int) * stack->size);
+    if(stack->ids == NULL){
+        diag_raise(stack->diag, 99, "Error: malloc failed");
     }
     stack->top_index = -1;
 }
@@ -36,11 +36,11 @@ bool sym_stack_full(sym_stack_t *stack){
 
 
 // Get item from stack
-ht_table_t *sym_stack_top(sym_stack_t *stack){
+int sym_stack_top(sym_stack_t *stack){
     if(sym_stack_empty(stack)){
-        return NULL;
+        return SYM_SCOPE_MARK;
     }
-    return stack->table[stack->top_index];
+    return stack->ids[stack->top_index];
 }
 
 
@@ -57,21 +57,20 @@ void sym_stack_pop(sym_stack_t *stack){
 void sym_stack_resize(sym_stack_t *stack){
     // printf("Resizing stack\n");
     stack->size *= 2;
-    stack->table = (ht_table_t **)realloc(stack->table, sizeof(ht_table_t *) * stack->size);
-    if(stack->table == NULL){
-        fprintf(stderr, "Error: realloc failed\n");
-        exit(99);
+    stack->ids = (int *)realloc(stack->ids, sizeof(int) * stack->size);
+    if(stack->ids == NULL){
+        diag_raise(stack->diag, 99, "Error: realloc failed");
     }
 }
 
 
 // Push item into stack
-void sym_stack_push(sym_stack_t *stack, ht_table_t *table){
+void sym_stack_push(sym_stack_t *stack, int id){
     if(sym_stack_full(stack)){
         sym_stack_resize(stack);
     }
     stack->top_index++;
-    stack->table[stack->top_index] = table;
+    stack->ids[stack->top_index] = id;
 }
 
 
@@ -80,5 +79,5 @@ void sym_stack_dispose(sym_stack_t *stack){
     while(!sym_stack_empty(stack)){
         sym_stack_pop(stack);
     }
-    free(stack->table);
+    free(stack->ids);
 }
\ No newline at end of file
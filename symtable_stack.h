@@ -11,26 +11,31 @@
 #include <stdbool.h>
 #include "hashtable.h"
 
+// Marks start of scope in the stack
+#define SYM_SCOPE_MARK -1
+
+// Ids of symbols declared in open scopes, in order of declaration
 typedef struct sym_stack{
-    ht_table_t **table;
+    int *ids;
     int size;
     int top_index;
+    diag_t *diag;   // allocation failure is reported here
 } sym_stack_t;
 
 // Inicialize stack
-void sym_stack_init(sym_stack_t *stack);
+void sym_stack_init(sym_stack_t *stack, diag_t *diag);
 
 // Check if stack is empty
 bool sym_stack_empty(sym_stack_t *stack);
 
 // Get item from stack
-ht_table_t *sym_stack_top(sym_stack_t *stack);
+int sym_stack_top(sym_stack_t *stack);
 
 // Pop item from stack
 void sym_stack_pop(sym_stack_t *stack);
 
 // Push item into stack
-void sym_stack_push(sym_stack_t *stack, ht_table_t *table);
+void sym_stack_push(sym_stack_t *stack, int id);
 
 // Delete all items from stack and stack
 void sym_stack_dispose(sym_stack_t *stack);
@@ -12,31 +12,31 @@
 #include "token.h"
 #include "expression.h"
 #include "ast.h"
-#include "codegen.h"
-#include "semantics.h"
+#include "intern.h"
+#include "arena.h"
+#include "compiler.h"
 
 
 // needed declarations
-token_t* in_param(token_t *token,  AST *ast);
-token_t* in_param_continuation(token_t *token,  AST *ast);
-token_t* param(token_t *token,  AST *ast);
-token_t* param_continuation(token_t *token, AST *ast);
+token_t* in_param(token_t *token, lexer_t *lexer, AST *ast, ast_list_t *list);
+token_t* in_param_continuation(token_t *token, lexer_t *lexer, AST *ast, ast_list_t *list);
+token_t* param(token_t *token, lexer_t *lexer, AST *ast, ast_list_t *list);
+token_t* param_continuation(token_t *token, lexer_t *lexer, AST *ast, ast_list_t *list);
 
 
 // <VARIABLE>
-int variable(token_t *token){
+int variable(token_t *token, lexer_t *lexer){
     if(token->type == eof_token){
-        fprintf(stderr, "Syntax error 1\n");
-        exit(2);
+        diag_raise(lexer->diag, 2, "Syntax error 1");
     }
 
     // <VARIABLE> -> var
-    if(strcmp(token->data, "var") == 0){
+    if(token->kind == kind_var){
         return 0;
     }
 
     // <VARIABLE> -> const
-    if(strcmp(token->data, "const") == 0){
+    if(token->kind == kind_const){
         return 0;
     }
 
@@ -45,29 +45,26 @@ int variable(token_t *token){
 
 
 // <TYPE>
-void type(token_t *token){
+void type(token_t *token, lexer_t *lexer){
     if(token->type == eof_token){
-        fprintf(stderr, "Syntax error 2\n");
-        exit(2);
+        diag_raise(lexer->diag, 2, "Syntax error 2");
     }
     if(token->type == type_token){
         return;
     }
 
-    if(strcmp(token->data, "void") == 0){
+    if(token->kind == kind_void){
         return;
     }
 
-    fprintf(stderr, "Syntax error 3\n");
-    exit(2);
+    diag_raise(lexer->diag, 2, "Syntax error 3");
 }
 
 
 // <TERM>
-int term(token_t *token){
+int term(token_t *token, lexer_t *lexer){
     if(token->type == eof_token){
-        fprintf(stderr, "Syntax error 4\n");
-        exit(2);
+        diag_raise(lexer->diag, 2, "Syntax error 4");
     }
     // <TERM> -> nejaky_int
     if(token->type == int_token){
@@ -93,19 +90,29 @@ int term(token_t *token){
 }
 
 
+// <EXPRESSION> or single null, which expression does not accept as first token
+// node of the expression is returned in node
+token_t *null_or_expression(token_t *token, lexer_t *lexer, AST *ast, ast_index_t *node){
+    if(token->type == null_token){
+        ast_postfix_push(ast, token);
+        *node = create_expression_node(ast);
+        return get_token(lexer);
+    }
+    return expression(token, lexer, ast, node);
+}
+
+
 // <IN_PARAM_CONTINUATION>
 // !!! don't call get_token() after this function !!!
-token_t *in_param_continuation(token_t *token, AST *ast){
+token_t *in_param_continuation(token_t *token, lexer_t *lexer, AST *ast, ast_list_t *list){
     if(token->type == eof_token){
-        fprintf(stderr, "Syntax error 5\n");
-        exit(2);
+        diag_raise(lexer->diag, 2, "Syntax error 5");
     }
 
     // <IN_PARAM_CONTINUATION> -> , <IN_PARAM>
-    if(strcmp(token->data, ",") == 0){
-        token = get_token();
-        create_node(token, ast);
-        token = in_param(token, ast);
+    if(token->kind == kind_comma){
+        token = get_token(lexer);
+        token = in_param(token, lexer, ast, list);
         return token;
     }
 
@@ -116,25 +123,19 @@ token_t *in_param_continuation(token_t *token, AST *ast){
 
 // <IN_PARAM>
 // !!! don't call get_token() after this function !!!
-token_t *in_param(token_t *token, AST *ast){
+token_t *in_param(token_t *token, lexer_t *lexer, AST *ast, ast_list_t *list){
     if(token->type == eof_token){
-        fprintf(stderr, "Syntax error 6\n");
-        exit(2);
+        diag_raise(lexer->diag, 2, "Syntax error 6");
     }
 
     // <IN_PARAM> -> ID <IN_PARAM_CONTINUATION>
-    if(token->type == identifier_token){
-        token = get_token();
-        create_node(token, ast);
-        token = in_param_continuation(token, ast);
-        return token;
-    }
-
     // <IN_PARAM> -> <TERM> <IN_PARAM_CONTINUATION>
-    if(term(token) == 0){
-        token = get_token();
-        create_node(token, ast);
-        token = in_param_continuation(token, ast);
+    if(token->type == identifier_token || term(token, lexer) == 0){
+        // argument is an expression of single term
+        ast_postfix_push(ast, token);
+        ast_append(ast, list, create_expression_node(ast));
+        token = get_token(lexer);
+        token = in_param_continuation(token, lexer, ast, list);
         return token;
     }
 
@@ -143,183 +144,170 @@ token_t *in_param(token_t *token, AST *ast){
 }
 
 
+// Turns node of expression ID followed by '(' into call of function ID
+// expression was the last one parsed, so its token is taken back from postfix array
+void call_node(AST *ast, ast_index_t node){
+    token_t *name = ast_postfix(ast, node, 0);
+    ast->postfix_count = ast->payload[node].postfix.start;
+    ast->postfix_start = ast->postfix_count;
+    ast->type[node] = node_call;
+    ast->payload[node].token = name;
+}
+
+
+// Appends new block to children of statement, returns list for statements of the block
+ast_list_t block(AST *ast, ast_list_t *children){
+    ast_index_t node = create_node(ast, node_block, NULL);
+    ast_append(ast, children, node);
+    return ast_list(node);
+}
+
+
 // <NEXT_VARIABLE_CONTINUATION>
-token_t *next_variable_continuaton(token_t *token, AST *ast){
+token_t *next_variable_continuaton(token_t *token, lexer_t *lexer, AST *ast, ast_index_t declaration){
     if(token->type == eof_token){
-        fprintf(stderr, "Syntax error 7\n");
-        exit(2);
+        diag_raise(lexer->diag, 2, "Syntax error 7");
     }
 
     // <NEXT_VARIABLE_CONTINUATION> -> <EXPRESSION>
-    if(token->type == null_token){
-        create_node(token, ast);
-        token = get_token();
-        create_node(token, ast);
-    }
-    else{
-        token = expression(token, ast);
-        create_node(token, ast);
-    }
+    ast_index_t value;
+    token = null_or_expression(token, lexer, ast, &value);
+    ast->child[declaration] = value;
 
-    if(strcmp(token->data, ";") == 0){
+    if(token->kind == kind_semicolon){
         return token;
     }
 
     // <NEXT_VARIABLE_CONTINUATION> -> ID ( <IN_PARAM> )
-    if(token->type == eof_token || strcmp(token->data, "(") != 0){
-        fprintf(stderr, "Syntax error 8\n");
-        exit(2);
-    }
-    token = get_token();
-    create_node(token, ast);
-    token = in_param(token, ast);
-    if(token->type == eof_token || strcmp(token->data, ")") != 0){
-        fprintf(stderr, "Syntax error 9\n");
-        exit(2);
-    }
-    token = get_token();
-    create_node(token, ast);
+    if(token->kind != kind_left_paren){
+        diag_raise(lexer->diag, 2, "Syntax error 8");
+    }
+    call_node(ast, value);
+    ast_list_t arguments = ast_list(value);
+    token = get_token(lexer);
+    token = in_param(token, lexer, ast, &arguments);
+    if(token->kind != kind_right_paren){
+        diag_raise(lexer->diag, 2, "Syntax error 9");
+    }
+    token = get_token(lexer);
     return token;
-
-    fprintf(stderr, "Syntax error 10\n");
-    exit(2);
 }
 
 
 // <VARIABLE_CONTINUATION>
-token_t *variable_continuation(token_t *token, AST *ast){
+token_t *variable_continuation(token_t *token, lexer_t *lexer, AST *ast, ast_index_t declaration){
     if(token->type == eof_token){
-        fprintf(stderr, "Syntax error 11\n");
-        exit(2);
+        diag_raise(lexer->diag, 2, "Syntax error 11");
     }
 
     // <VARIABLE_CONTINUATION> -> : <TYPE> = <NEXT_VARIABLE_CONTINUATION>
-    if(strcmp(token->data, ":") == 0){
-        token = get_token();
-        create_node(token, ast);
-        type(token);
-        token = get_token();
-        create_node(token, ast);
-        if(token->type == eof_token || strcmp(token->data, "=") != 0){
-            fprintf(stderr, "Syntax error 12\n");
-            exit(2);
-        }
-        token = get_token();
-        token = next_variable_continuaton(token, ast);
+    if(token->kind == kind_colon){
+        token = get_token(lexer);
+        type(token, lexer);
+        ast->data_type[declaration] = token->kind;
+        token = get_token(lexer);
+        if(token->kind != kind_assign){
+            diag_raise(lexer->diag, 2, "Syntax error 12");
+        }
+        token = get_token(lexer);
+        token = next_variable_continuaton(token, lexer, ast, declaration);
         return token;
     }
 
     // <VARIABLE_CONTINUATION> -> = <NEXT_VARIABLE_CONTINUATION>
-    if(strcmp(token->data, "=") == 0){
-        token = get_token();
-        token = next_variable_continuaton(token, ast);
+    if(token->kind == kind_assign){
+        token = get_token(lexer);
+        token = next_variable_continuaton(token, lexer, ast, declaration);
         return token;
     }
 
-    fprintf(stderr, "Syntax error 13\n");
-    exit(2);
+    diag_raise(lexer->diag, 2, "Syntax error 13");
 }
 
 
 // <NEXT_ID_DEFINING>
-token_t *next_id_defining(token_t *token, AST *ast){
+token_t *next_id_defining(token_t *token, lexer_t *lexer, AST *ast, ast_index_t assignment){
     if(token->type == eof_token){
-        fprintf(stderr, "Syntax error 14\n");
-        exit(2);
+        diag_raise(lexer->diag, 2, "Syntax error 14");
     }
 
     // <NEXT_ID_DEFINING> -> <EXPRESSION>
-    if(token->type == null_token){
-        create_node(token, ast);
-        token = get_token();
-        create_node(token, ast);
-    }
-    else{
-        token = expression(token, ast);
-        create_node(token, ast);
-    }
+    ast_index_t value;
+    token = null_or_expression(token, lexer, ast, &value);
+    ast->child[assignment] = value;
 
-    if(strcmp(token->data, ";") == 0){
+    if(token->kind == kind_semicolon){
         return token;
     }
 
     // <NEXT_ID_DEFINING> -> ID ( <IN_PARAM> )
-    if(strcmp(token->data, "(") == 0){
-        token = get_token();
-        create_node(token, ast);
-        token = in_param(token, ast);
-        if(token->type == eof_token || strcmp(token->data, ")") != 0){
-            fprintf(stderr, "Syntax error 15\n");
-            exit(2);
-        }
-        token = get_token();
-        create_node(token, ast);
+    if(token->kind == kind_left_paren){
+        call_node(ast, value);
+        ast_list_t arguments = ast_list(value);
+        token = get_token(lexer);
+        token = in_param(token, lexer, ast, &arguments);
+        if(token->kind != kind_right_paren){
+            diag_raise(lexer->diag, 2, "Syntax error 15");
+        }
+        token = get_token(lexer);
         return token;
     }
 
-    fprintf(stderr, "Syntax error 16\n");
-    exit(2);
+    diag_raise(lexer->diag, 2, "Syntax error 16");
 }
 
 
 
 // <ID_DEFINING>
-token_t *id_defining(token_t *token, AST *ast){
+// statement is assignment to ID, it is changed to call if ID is called
+token_t *id_defining(token_t *token, lexer_t *lexer, AST *ast, ast_index_t statement){
     if(token->type == eof_token){
-        fprintf(stderr, "Syntax error 17\n");
-        exit(2);
+        diag_raise(lexer->diag, 2, "Syntax error 17");
     }
 
     // <ID_DEFINING> -> = <NEXT_ID_DEFINING>
-    if(strcmp(token->data, "=") == 0){
-        token = get_token();
-        token = next_id_defining(token, ast);
+    if(token->kind == kind_assign){
+        token = get_token(lexer);
+        token = next_id_defining(token, lexer, ast, statement);
         return token;
     }
 
     // <ID_DEFINING> -> ( <IN_PARAM> )
-    if(strcmp(token->data, "(") == 0){
-        token = get_token();
-        create_node(token, ast);
-        token = in_param(token, ast);
-        if(token->type == eof_token || strcmp(token->data, ")") != 0){
-            fprintf(stderr, "Syntax error 18\n");
-            exit(2);
-        }
-        token = get_token();
-        create_node(token, ast);
+    if(token->kind == kind_left_paren){
+        ast->type[statement] = node_call;
+        ast_list_t arguments = ast_list(statement);
+        token = get_token(lexer);
+        token = in_param(token, lexer, ast, &arguments);
+        if(token->kind != kind_right_paren){
+            diag_raise(lexer->diag, 2, "Syntax error 18");
+        }
+        token = get_token(lexer);
         return token;
     }
 
-    fprintf(stderr, "Syntax error 19\n");
-    exit(2);
+    diag_raise(lexer->diag, 2, "Syntax error 19");
 }
 
 
 // <WHILE_IF_EXTENSION>
 // !!! don't call get_token() after this function !!!
-token_t *while_if_extension(token_t *token, AST *ast){
+token_t *while_if_extension(token_t *token, lexer_t *lexer, AST *ast, ast_index_t statement){
     if(token->type == eof_token){
-        fprintf(stderr, "Syntax error 20\n");
-        exit(2);
+        diag_raise(lexer->diag, 2, "Syntax error 20");
     }
 
     // <WHILE_IF_EXTENSION> -> | ID |
-    if(strcmp(token->data, "|") == 0){
-        token = get_token();
-        create_node(token, ast);
+    if(token->kind == kind_pipe){
+        token = get_token(lexer);
         if(token->type != identifier_token){
-            fprintf(stderr, "Syntax error 21\n");
-            exit(2);
+            diag_raise(lexer->diag, 2, "Syntax error 21");
         }
-        token = get_token();
-        create_node(token, ast);
-        if(token->type == eof_token || strcmp(token->data, "|") != 0){
-            fprintf(stderr, "Syntax error 22\n");
-            exit(2);
+        ast->payload[statement].token = token;
+        token = get_token(lexer);
+        if(token->kind != kind_pipe){
+            diag_raise(lexer->diag, 2, "Syntax error 22");
         }
-        token = get_token();
-        create_node(token, ast);
+        token = get_token(lexer);
         return token;
     }
 
@@ -330,17 +318,15 @@ token_t *while_if_extension(token_t *token, AST *ast){
 
 // <PARAM_CONTINUATION>
 // !!! don't call get_token() after this function !!!
-token_t *param_continuation(token_t *token, AST *ast){
+token_t *param_continuation(token_t *token, lexer_t *lexer, AST *ast, ast_list_t *list){
     if(token->type == eof_token){
-        fprintf(stderr, "Syntax error 23\n");
-        exit(2);
+        diag_raise(lexer->diag, 2, "Syntax error 23");
     }
 
     // <PARAM_CONTINUATION> -> , <PARAM>
-    if(strcmp(token->data, ",") == 0){
-        token = get_token();
-        create_node(token, ast);
-        token = param(token, ast);
+    if(token->kind == kind_comma){
+        token = get_token(lexer);
+        token = param(token, lexer, ast, list);
         return token;
     }
 
@@ -352,26 +338,24 @@ token_t *param_continuation(token_t *token, AST *ast){
 
 // <PARAM>
 // !!! don't call get_token() after this function !!!
-token_t *param(token_t *token, AST *ast){
+token_t *param(token_t *token, lexer_t *lexer, AST *ast, ast_list_t *list){
     if(token->type == eof_token){
-        fprintf(stderr, "Syntax error 24\n");
-        exit(2);
+        diag_raise(lexer->diag, 2, "Syntax error 24");
     }
 
     //<PARAM> -> ID : <TYPE> <PARAM_CONTINUATION>
     if(token->type == identifier_token){
-        token = get_token();
-        create_node(token, ast);
-        if(token->type == eof_token || strcmp(token->data, ":") != 0){
-            fprintf(stderr, "Syntax error 25\n");
-            exit(2);
-        }
-        token = get_token();
-        create_node(token, ast);
-        type(token);
-        token = get_token();
-        create_node(token, ast);
-        token = param_continuation(token, ast);
+        ast_index_t parameter = create_node(ast, node_param, token);
+        ast_append(ast, list, parameter);
+        token = get_token(lexer);
+        if(token->kind != kind_colon){
+            diag_raise(lexer->diag, 2, "Syntax error 25");
+        }
+        token = get_token(lexer);
+        type(token, lexer);
+        ast->data_type[parameter] = token->kind;
+        token = get_token(lexer);
+        token = param_continuation(token, lexer, ast, list);
         return token;
     }
 
@@ -382,51 +366,41 @@ token_t *param(token_t *token, AST *ast){
 
 // <RETURN_VALUE>
 // !!! don't call get_token() after this function !!!
-token_t *return_value(token_t *token, AST *ast){
+token_t *return_value(token_t *token, lexer_t *lexer, AST *ast, ast_index_t statement){
     if(token->type == eof_token){
-        fprintf(stderr, "Syntax error 26\n");
-        exit(2);
+        diag_raise(lexer->diag, 2, "Syntax error 26");
     }
 
-    if(token->type == null_token){
-        create_node(token, ast);
-        token = get_token();
-        create_node(token, ast);
-        return token;
-    }
-    else if(token->type == semicolon_token){
-        create_node(token, ast);
-        return token;
-    }
-    else{
-        token = expression(token, ast);
-        create_node(token, ast);
+    // <RETURN_VALUE> -> ε
+    if(token->type == semicolon_token){
         return token;
     }
 
-    // <RETURN_VALUE> -> ε
+    // <RETURN_VALUE> -> <EXPRESSION>
+    ast_index_t value;
+    token = null_or_expression(token, lexer, ast, &value);
+    ast->child[statement] = value;
     return token;
 }
 
 
 // <FUNC_EXTENSION>
 // !!! don't call get_token() after this function !!!
-token_t *func_extension(token_t *token, AST *ast){
+token_t *func_extension(token_t *token, lexer_t *lexer, AST *ast, ast_list_t *list){
     if(token->type == eof_token){
-        fprintf(stderr, "Syntax error 27\n");
-        exit(2);
+        diag_raise(lexer->diag, 2, "Syntax error 27");
     }
 
     // <FUNC_EXTENSION> -> return <RETURN_VALUE>
-    if(strcmp(token->data, "return") == 0){
-        token = get_token();
-        token = return_value(token, ast);
-        if(token->type == eof_token || strcmp(token->data, ";") != 0){
-            fprintf(stderr, "Syntax error 28\n");
-            exit(2);
-        }
-        token = get_token();
-        create_node(token, ast);
+    if(token->kind == kind_return){
+        ast_index_t statement = create_node(ast, node_return, NULL);
+        ast_append(ast, list, statement);
+        token = get_token(lexer);
+        token = return_value(token, lexer, ast, statement);
+        if(token->kind != kind_semicolon){
+            diag_raise(lexer->diag, 2, "Syntax error 28");
+        }
+        token = get_token(lexer);
         return token;
     }
 
@@ -436,421 +410,342 @@ token_t *func_extension(token_t *token, AST *ast){
 
 
 // <CODE_SEQUENCE>
+// statements are appended to list, one after another
 // !!! don't call get_token() after this function !!!
-token_t *code_sequence(token_t *token, AST *ast){
-    if(token->type == eof_token){
-        fprintf(stderr, "Syntax error 29\n");
-        exit(2);
-    }
-
-    // <CODE_SEQUENCE> -> <VARIABLE> ID <VARIABLE_CONTINUATION> ; <CODE_SEQUENCE>
-    if(variable(token) == 0){
-        token = get_token();
-        create_node(token, ast);
-        if(token->type != identifier_token){
-            fprintf(stderr, "Syntax error 30\n");
-            exit(2);
-        }
-        token = get_token();
-        create_node(token, ast);
-        token = variable_continuation(token, ast);
-        if(token->type == eof_token || strcmp(token->data, ";") != 0){
-            fprintf(stderr, "Syntax error 31\n");
-            exit(2);
-        }
-        token = get_token();
-        create_node(token, ast);
-        token = code_sequence(token, ast);
-        return token;
-    }
-
-
-    // <CODE_SEQUENCE> -> ID <ID_DEFINING> ; <CODE_SEQUENCE>
-    if(token->type == identifier_token){
-        token = get_token();
-        create_node(token, ast);
-        token = id_defining(token, ast);
-        if(token->type == eof_token || strcmp(token->data, ";") != 0){
-            fprintf(stderr, "Syntax error 32\n");
-            exit(2);
-        }
-        token = get_token();
-        create_node(token, ast);
-        token = code_sequence(token, ast);
-        return token;
-    }
-
-    // <CODE_SEQUENCE> -> if ( <EXPRESSION> ) <WHILE_IF_EXTENSION> { <CODE_SEQUENCE> } else { <CODE_SEQUENCE> } <CODE_SEQUENCE>
-    if(token->type != eof_token && strcmp(token->data, "if") == 0){
-        token = get_token();
-        create_node(token, ast);
-        if(token->type == eof_token || strcmp(token->data, "(") != 0){
-            fprintf(stderr, "Syntax error 33\n");
-            exit(2);
-        }
-        token = get_token();
-        if(token->type == null_token){
-            create_node(token, ast);
-            token = get_token();
-            create_node(token, ast);
-        }
-        else{
-            token = expression(token, ast);
-            create_node(token, ast);
-        }
-        if(token->type == eof_token || strcmp(token->data, ")") != 0){
-            fprintf(stderr, "Syntax error 34\n");
-            exit(2);
-        }
-        token = get_token();
-        create_node(token, ast);
-        token = while_if_extension(token, ast);
-        if(token->type == eof_token || strcmp(token->data, "{") != 0){
-            fprintf(stderr, "Syntax error 35\n");
-            exit(2);
-        }
-        token = get_token();
-        create_node(token, ast);
-        token = code_sequence(token, ast);
-        if(token->type == eof_token || strcmp(token->data, "}") != 0){
-            fprintf(stderr, "Syntax error 36\n");
-            exit(2);
-        }
-        token = get_token();
-        create_node(token, ast);
-        if(token->type == eof_token || strcmp(token->data, "else") != 0){
-            fprintf(stderr, "Syntax error 37\n");
-            exit(2);
-        }
-        token = get_token();
-        create_node(token, ast);
-        if(token->type == eof_token || strcmp(token->data, "{") != 0){
-            fprintf(stderr, "Syntax error 38\n");
-            exit(2);
-        }
-        token = get_token();
-        create_node(token, ast);
-        token = code_sequence(token, ast);
-        if(token->type == eof_token || strcmp(token->data, "}") != 0){
-            fprintf(stderr, "Syntax error 39\n");
-            exit(2);
-        }
-        token = get_token();
-        create_node(token, ast);
-        token = code_sequence(token, ast);
-        return token;
-    }
-
-    // <CODE_SEQUENCE> -> while ( <EXPRESSION> ) <WHILE_IF_EXTENSION> { <CODE_SEQUENCE> } <CODE_SEQUENCE>
-    if(token->type != eof_token && strcmp(token->data, "while") == 0){
-        token = get_token();
-        create_node(token, ast);
-        if(token->type == eof_token || strcmp(token->data, "(") != 0){
-            fprintf(stderr, "Syntax error 40\n");
-            exit(2);
-        }
-        token = get_token();
-        if(token->type == null_token){
-            create_node(token, ast);
-            token = get_token();
-            create_node(token, ast);
-        }
-        else{
-            token = expression(token, ast);
-            create_node(token, ast);
-        }
-        if(token->type == eof_token || strcmp(token->data, ")") != 0){
-            fprintf(stderr, "Syntax error 41\n");
-            exit(2);
-        }
-        token = get_token();
-        create_node(token, ast);
-        token = while_if_extension(token, ast);
-        if(token->type == eof_token || strcmp(token->data, "{") != 0){
-            fprintf(stderr, "Syntax error 42\n");
-            exit(2);
-        }
-        token = get_token();
-        create_node(token, ast);
-        token = code_sequence(token, ast);
-        if(token->type == eof_token || strcmp(token->data, "}") != 0){
-            fprintf(stderr, "Syntax error 43\n");
-            exit(2);
-        }
-        token = get_token();
-        create_node(token, ast);
-        token = code_sequence(token, ast);
+token_t *code_sequence(token_t *token, lexer_t *lexer, AST *ast, ast_list_t *list){
+    // statements of one block are parsed in a loop, only nested blocks recurse
+    while(true){
+        if(token->type == eof_token){
+            diag_raise(lexer->diag, 2, "Syntax error 29");
+        }
+
+        // <CODE_SEQUENCE> -> <VARIABLE> ID <VARIABLE_CONTINUATION> ; <CODE_SEQUENCE>
+        if(variable(token, lexer) == 0){
+            ast_index_t statement = create_node(ast, node_var_decl, NULL);
+            ast->constant[statement] = token->kind == kind_const;
+            ast_append(ast, list, statement);
+            token = get_token(lexer);
+            if(token->type != identifier_token){
+                diag_raise(lexer->diag, 2, "Syntax error 30");
+            }
+            ast->payload[statement].token = token;
+            token = get_token(lexer);
+            token = variable_continuation(token, lexer, ast, statement);
+            if(token->kind != kind_semicolon){
+                diag_raise(lexer->diag, 2, "Syntax error 31");
+            }
+            token = get_token(lexer);
+            continue;
+        }
+
+
+        // <CODE_SEQUENCE> -> ID <ID_DEFINING> ; <CODE_SEQUENCE>
+        if(token->type == identifier_token){
+            ast_index_t statement = create_node(ast, node_assignment, token);
+            ast_append(ast, list, statement);
+            token = get_token(lexer);
+            token = id_defining(token, lexer, ast, statement);
+            if(token->kind != kind_semicolon){
+                diag_raise(lexer->diag, 2, "Syntax error 32");
+            }
+            token = get_token(lexer);
+            continue;
+        }
+
+        // <CODE_SEQUENCE> -> if ( <EXPRESSION> ) <WHILE_IF_EXTENSION> { <CODE_SEQUENCE> } else { <CODE_SEQUENCE> } <CODE_SEQUENCE>
+        if(token->kind == kind_if){
+            ast_index_t statement = create_node(ast, node_if, NULL);
+            ast_append(ast, list, statement);
+            ast_list_t children = ast_list(statement);
+            token = get_token(lexer);
+            if(token->kind != kind_left_paren){
+                diag_raise(lexer->diag, 2, "Syntax error 33");
+            }
+            token = get_token(lexer);
+            ast_index_t condition;
+            token = null_or_expression(token, lexer, ast, &condition);
+            ast_append(ast, &children, condition);
+            if(token->kind != kind_right_paren){
+                diag_raise(lexer->diag, 2, "Syntax error 34");
+            }
+            token = get_token(lexer);
+            token = while_if_extension(token, lexer, ast, statement);
+            if(token->kind != kind_left_brace){
+                diag_raise(lexer->diag, 2, "Syntax error 35");
+            }
+            token = get_token(lexer);
+            ast_list_t body = block(ast, &children);
+            token = code_sequence(token, lexer, ast, &body);
+            if(token->kind != kind_right_brace){
+                diag_raise(lexer->diag, 2, "Syntax error 36");
+            }
+            token = get_token(lexer);
+            if(token->kind != kind_else){
+                diag_raise(lexer->diag, 2, "Syntax error 37");
+            }
+            token = get_token(lexer);
+            if(token->kind != kind_left_brace){
+                diag_raise(lexer->diag, 2, "Syntax error 38");
+            }
+            token = get_token(lexer);
+            ast_list_t else_body = block(ast, &children);
+            token = code_sequence(token, lexer, ast, &else_body);
+            if(token->kind != kind_right_brace){
+                diag_raise(lexer->diag, 2, "Syntax error 39");
+            }
+            token = get_token(lexer);
+            continue;
+        }
+
+        // <CODE_SEQUENCE> -> while ( <EXPRESSION> ) <WHILE_IF_EXTENSION> { <CODE_SEQUENCE> } <CODE_SEQUENCE>
+        if(token->kind == kind_while){
+            ast_index_t statement = create_node(ast, node_while, NULL);
+            ast_append(ast, list, statement);
+            ast_list_t children = ast_list(statement);
+            token = get_token(lexer);
+            if(token->kind != kind_left_paren){
+                diag_raise(lexer->diag, 2, "Syntax error 40");
+            }
+            token = get_token(lexer);
+            ast_index_t condition;
+            token = null_or_expression(token, lexer, ast, &condition);
+            ast_append(ast, &children, condition);
+            if(token->kind != kind_right_paren){
+                diag_raise(lexer->diag, 2, "Syntax error 41");
+            }
+            token = get_token(lexer);
+            token = while_if_extension(token, lexer, ast, statement);
+            if(token->kind != kind_left_brace){
+                diag_raise(lexer->diag, 2, "Syntax error 42");
+            }
+            token = get_token(lexer);
+            ast_list_t body = block(ast, &children);
+            token = code_sequence(token, lexer, ast, &body);
+            if(token->kind != kind_right_brace){
+                diag_raise(lexer->diag, 2, "Syntax error 43");
+            }
+            token = get_token(lexer);
+            continue;
+        }
+
+        // <CODE_SEQUENCE> -> <FUNC_EXTENSION>
+        token = func_extension(token, lexer, ast, list);
+
+        // <CODE_SEQUENCE> -> ε
         return token;
     }
-
-    // <CODE_SEQUENCE> -> <FUNC_EXTENSION>
-    token = func_extension(token, ast);
-
-    // <CODE_SEQUENCE> -> ε
-    return token;
 }
 
 
 // <CODE>
-void code(token_t *token, AST *ast){
-    // <CODE> -> EOF
-    if(token->type == eof_token){
-        return;
-    }
-
-    // <CODE> -> <VARIABLE> ID <VARIABLE_CONTINUATION> ; <CODE>
-    if(variable(token) == 0){
-        token = get_token();
-        create_node(token, ast);
-        if(token->type != identifier_token){
-            fprintf(stderr, "Syntax error 44\n");
-            exit(2);
-        }
-        token = get_token();
-        create_node(token, ast);
-        token = variable_continuation(token, ast);
-        if(token->type == eof_token || strcmp(token->data, ";") != 0){
-            fprintf(stderr, "Syntax error 45\n");
-            exit(2);
-        }
-        token = get_token();
-        create_node(token, ast);
-        code(token, ast);
-        return;
-    }
-
-    // <CODE> -> ID <ID_DEFINING> ; <CODE>
-    if(token->type == identifier_token){
-        token = get_token();
-        create_node(token, ast);
-        token = id_defining(token, ast);
-        if(token->type == eof_token || strcmp(token->data, ";") != 0){
-            fprintf(stderr, "Syntax error 46\n");
-            exit(2);
-        }
-        token = get_token();
-        create_node(token, ast);
-        code(token, ast);
-        return;
-    }
-
-    // <CODE> -> if ( <EXPRESSION> ) <WHILE_IF_EXTENSION> { <CODE_SEQUENCE> } else { <CODE_SEQUENCE> } <CODE>
-    if(token->type != eof_token && strcmp(token->data, "if") == 0){
-        token = get_token();
-        create_node(token, ast);
-        if(token->type == eof_token || strcmp(token->data, "(") != 0){
-            fprintf(stderr, "Syntax error 47\n");
-            exit(2);
-        }
-        token = get_token();
-        if(token->type == null_token){
-            create_node(token, ast);
-            token = get_token();
-            create_node(token, ast);
-        }
-        else{
-            token = expression(token, ast);
-            create_node(token, ast);
-        }
-        if(token->type == eof_token || strcmp(token->data, ")") != 0){
-            fprintf(stderr, "Syntax error 48\n");
-            exit(2);
-        }
-        token = get_token();
-        create_node(token, ast);
-        token = while_if_extension(token, ast);
-        if(token->type == eof_token || strcmp(token->data, "{") != 0){
-            fprintf(stderr, "Syntax error 49\n");
-            exit(2);
-        }
-        token = get_token();
-        create_node(token, ast);
-        token = code_sequence(token, ast);
-        if(token->type == eof_token || strcmp(token->data, "}") != 0){
-            fprintf(stderr, "Syntax error 50\n");
-            exit(2);
-        }
-        token = get_token();
-        create_node(token, ast);
-        if(token->type == eof_token || strcmp(token->data, "else") != 0){
-            fprintf(stderr, "Syntax error 51\n");
-            exit(2);
-        }
-        token = get_token();
-        create_node(token, ast);
-        if(token->type == eof_token || strcmp(token->data, "{") != 0){
-            fprintf(stderr, "Syntax error 52\n");
-            exit(2);
-        }
-        token = get_token();
-        create_node(token, ast);
-        token = code_sequence(token, ast);
-        if(token->type == eof_token || strcmp(token->data, "}") != 0){
-            fprintf(stderr, "Syntax error 53\n");
-            exit(2);
-        }
-        token = get_token();
-        create_node(token, ast);
-        code(token, ast);
-        return;
-    }
-
-    // <CODE> -> while ( <EXPRESSION> ) <WHILE_IF_EXTENSION> { <CODE_SEQUENCE> } <CODE>
-    if(token->type != eof_token && strcmp(token->data, "while") == 0){
-        token = get_token();
-        create_node(token, ast);
-        if(token->type == eof_token || strcmp(token->data, "(") != 0){
-            fprintf(stderr, "Syntax error 54\n");
-            exit(2);
-        }
-        token = get_token();
-        if(token->type == null_token){
-            create_node(token, ast);
-            token = get_token();
-            create_node(token, ast);
-        }
-        else{
-            token = expression(token, ast);
-            create_node(token, ast);
-        }
-        if(token->type == eof_token || strcmp(token->data, ")") != 0){
-            fprintf(stderr, "Syntax error 55\n");
-            exit(2);
-        }
-        token = get_token();
-        create_node(token, ast);
-        token = while_if_extension(token, ast);
-        if(token->type == eof_token || strcmp(token->data, "{") != 0){
-            fprintf(stderr, "Syntax error 56\n");
-            exit(2);
-        }
-        token = get_token();
-        create_node(token, ast);
-        token = code_sequence(token, ast);
-        if(token->type == eof_token || strcmp(token->data, "}") != 0){
-            fprintf(stderr, "Syntax error 57\n");
-            exit(2);
-        }
-        token = get_token();
-        create_node(token, ast);
-        code(token, ast);
-        return;
+void code(token_t *token, lexer_t *lexer, AST *ast){
+    // top level statements are appended to root of ast
+    ast_list_t root = ast_list(ast->root);
+    ast_list_t *list = &root;
+
+    // top level statements are parsed in a loop, only blocks recurse
+    while(true){
+        // <CODE> -> EOF
+        if(token->type == eof_token){
+            return;
+        }
+
+        // <CODE> -> <VARIABLE> ID <VARIABLE_CONTINUATION> ; <CODE>
+        if(variable(token, lexer) == 0){
+            ast_index_t statement = create_node(ast, node_var_decl, NULL);
+            ast->constant[statement] = token->kind == kind_const;
+            ast_append(ast, list, statement);
+            token = get_token(lexer);
+            if(token->type != identifier_token){
+                diag_raise(lexer->diag, 2, "Syntax error 44");
+            }
+            ast->payload[statement].token = token;
+            token = get_token(lexer);
+            token = variable_continuation(token, lexer, ast, statement);
+            if(token->kind != kind_semicolon){
+                diag_raise(lexer->diag, 2, "Syntax error 45");
+            }
+            token = get_token(lexer);
+            continue;
+        }
+
+        // <CODE> -> ID <ID_DEFINING> ; <CODE>
+        if(token->type == identifier_token){
+            ast_index_t statement = create_node(ast, node_assignment, token);
+            ast_append(ast, list, statement);
+            token = get_token(lexer);
+            token = id_defining(token, lexer, ast, statement);
+            if(token->kind != kind_semicolon){
+                diag_raise(lexer->diag, 2, "Syntax error 46");
+            }
+            token = get_token(lexer);
+            continue;
+        }
+
+        // <CODE> -> if ( <EXPRESSION> ) <WHILE_IF_EXTENSION> { <CODE_SEQUENCE> } else { <CODE_SEQUENCE> } <CODE>
+        if(token->kind == kind_if){
+            ast_index_t statement = create_node(ast, node_if, NULL);
+            ast_append(ast, list, statement);
+            ast_list_t children = ast_list(statement);
+            token = get_token(lexer);
+            if(token->kind != kind_left_paren){
+                diag_raise(lexer->diag, 2, "Syntax error 47");
+            }
+            token = get_token(lexer);
+            ast_index_t condition;
+            token = null_or_expression(token, lexer, ast, &condition);
+            ast_append(ast, &children, condition);
+            if(token->kind != kind_right_paren){
+                diag_raise(lexer->diag, 2, "Syntax error 48");
+            }
+            token = get_token(lexer);
+            token = while_if_extension(token, lexer, ast, statement);
+            if(token->kind != kind_left_brace){
+                diag_raise(lexer->diag, 2, "Syntax error 49");
+            }
+            token = get_token(lexer);
+            ast_list_t body = block(ast, &children);
+            token = code_sequence(token, lexer, ast, &body);
+            if(token->kind != kind_right_brace){
+                diag_raise(lexer->diag, 2, "Syntax error 50");
+            }
+            token = get_token(lexer);
+            if(token->kind != kind_else){
+                diag_raise(lexer->diag, 2, "Syntax error 51");
+            }
+            token = get_token(lexer);
+            if(token->kind != kind_left_brace){
+                diag_raise(lexer->diag, 2, "Syntax error 52");
+            }
+            token = get_token(lexer);
+            ast_list_t else_body = block(ast, &children);
+            token = code_sequence(token, lexer, ast, &else_body);
+            if(token->kind != kind_right_brace){
+                diag_raise(lexer->diag, 2, "Syntax error 53");
+            }
+            token = get_token(lexer);
+            continue;
+        }
+
+        // <CODE> -> while ( <EXPRESSION> ) <WHILE_IF_EXTENSION> { <CODE_SEQUENCE> } <CODE>
+        if(token->kind == kind_while){
+            ast_index_t statement = create_node(ast, node_while, NULL);
+            ast_append(ast, list, statement);
+            ast_list_t children = ast_list(statement);
+            token = get_token(lexer);
+            if(token->kind != kind_left_paren){
+                diag_raise(lexer->diag, 2, "Syntax error 54");
+            }
+            token = get_token(lexer);
+            ast_index_t condition;
+            token = null_or_expression(token, lexer, ast, &condition);
+            ast_append(ast, &children, condition);
+            if(token->kind != kind_right_paren){
+                diag_raise(lexer->diag, 2, "Syntax error 55");
+            }
+            token = get_token(lexer);
+            token = while_if_extension(token, lexer, ast, statement);
+            if(token->kind != kind_left_brace){
+                diag_raise(lexer->diag, 2, "Syntax error 56");
+            }
+            token = get_token(lexer);
+            ast_list_t body = block(ast, &children);
+            token = code_sequence(token, lexer, ast, &body);
+            if(token->kind != kind_right_brace){
+                diag_raise(lexer->diag, 2, "Syntax error 57");
+            }
+            token = get_token(lexer);
+            continue;
+        }
+
+        // <CODE> -> pub fn ID ( <PARAM> ) <TYPE> { <CODE_SEQUENCE> } <CODE>
+        if(token->kind == kind_pub){
+            ast_index_t statement = create_node(ast, node_function, NULL);
+            ast_append(ast, list, statement);
+            ast_list_t children = ast_list(statement);
+            token = get_token(lexer);
+            if(token->kind != kind_fn){
+                diag_raise(lexer->diag, 2, "Syntax error 58");
+            }
+            token = get_token(lexer);
+            if(token->type != identifier_token){
+                diag_raise(lexer->diag, 2, "Syntax error 59");
+            }
+            ast->payload[statement].token = token;
+            token = get_token(lexer);
+            if(token->kind != kind_left_paren){
+                diag_raise(lexer->diag, 2, "Syntax error 60");
+            }
+            token = get_token(lexer);
+            token = param(token, lexer, ast, &children);
+            if(token->kind != kind_right_paren){
+                diag_raise(lexer->diag, 2, "Syntax error 61");
+            }
+            token = get_token(lexer);
+            type(token, lexer);
+            ast->data_type[statement] = token->kind;
+            // Signature is complete, calls before the definition can be checked against it
+            ast_add_function(ast, statement);
+            token = get_token(lexer);
+            if(token->kind != kind_left_brace){
+                diag_raise(lexer->diag, 2, "Syntax error 62");
+            }
+            token = get_token(lexer);
+            ast_list_t body = block(ast, &children);
+            token = code_sequence(token, lexer, ast, &body);
+            if(token->kind != kind_right_brace){
+                diag_raise(lexer->diag, 2, "Syntax error 63");
+            }
+            token = get_token(lexer);
+            continue;
+        }
+
+        diag_raise(lexer->diag, 2, "Syntax error 64");
     }
-
-    // <CODE> -> pub fn ID ( <PARAM> ) <TYPE> { <CODE_SEQUENCE> } <CODE>
-    if(token->type != eof_token && strcmp(token->data, "pub") == 0){
-        token = get_token();
-        create_node(token, ast);
-        if(token->type == eof_token || strcmp(token->data, "fn") != 0){
-            fprintf(stderr, "Syntax error 58\n");
-            exit(2);
-        }
-        token = get_token();
-        create_node(token, ast);
-        if(token->type != identifier_token){
-            fprintf(stderr, "Syntax error 59\n");
-            exit(2);
-        }
-        token = get_token();
-        create_node(token, ast);
-        if(token->type == eof_token || strcmp(token->data, "(") != 0){
-            fprintf(stderr, "Syntax error 60\n");
-            exit(2);
-        }
-        token = get_token();
-        create_node(token, ast);
-        token = param(token, ast);
-        if(token->type == eof_token || strcmp(token->data, ")") != 0){
-            fprintf(stderr, "Syntax error 61\n");
-            exit(2);
-        }
-        token = get_token();
-        create_node(token, ast);
-        type(token);
-        token = get_token();
-        create_node(token, ast);
-        if(token->type == eof_token || strcmp(token->data, "{") != 0){
-            fprintf(stderr, "Syntax error 62\n");
-            exit(2);
-        }
-        token = get_token();
-        create_node(token, ast);
-        token = code_sequence(token, ast);
-        if(token->type == eof_token || strcmp(token->data, "}") != 0){
-            fprintf(stderr, "Syntax error 63\n");
-            exit(2);
-        }
-        token = get_token();
-        create_node(token, ast);
-        code(token, ast);
-        return;
-    }
-
-    fprintf(stderr, "Syntax error 64\n");
-    exit(2);
 }
 
 
-int main(){
-    // AST Initialization
-    AST *ast = create_ast();
-    
-    token_t *token = get_token();
+// Parses source loaded in compiler lexer and builds its AST
+void parse(compiler_t *compiler){
+    lexer_t *lexer = &compiler->lexer;
+    AST *ast = compiler->ast;
+
+    token_t *token = get_token(lexer);
 
     // Check for header
-    if(token->type == eof_token || strcmp(token->data, "const") != 0){
-        fprintf(stderr, "Syntax error 65\n");
-        exit(2);
+    if(token->kind != kind_const){
+        diag_raise(lexer->diag, 2, "Syntax error 65");
     }
-    token = get_token();
-    if(token->type == eof_token || strcmp(token->data, "ifj") != 0){
-        fprintf(stderr, "Syntax error 66\n");
-        exit(2);
+    token = get_token(lexer);
+    if(token->type != identifier_token || strcmp(token->data, "ifj") != 0){
+        diag_raise(lexer->diag, 2, "Syntax error 66");
     }
-    token = get_token();
+    token = get_token(lexer);
     if(token->type != equal_token){
-        fprintf(stderr, "Syntax error 67\n");
-        exit(2);
+        diag_raise(lexer->diag, 2, "Syntax error 67");
     }
-    token = get_token();
+    token = get_token(lexer);
     if(token->type != import_token){
-        fprintf(stderr, "Syntax error 68\n");
-        exit(2);
+        diag_raise(lexer->diag, 2, "Syntax error 68");
     }
-    token = get_token();
-    if(token->type == eof_token || strcmp(token->data, "(") != 0){
-        fprintf(stderr, "Syntax error 69\n");
-        exit(2);
+    token = get_token(lexer);
+    if(token->kind != kind_left_paren){
+        diag_raise(lexer->diag, 2, "Syntax error 69");
     }
-    token = get_token();
-    if(token->type == eof_token || strcmp(token->data, "ifj24.zig") != 0){
-        fprintf(stderr, "Syntax error 70\n");
-        exit(2);
+    token = get_token(lexer);
+    if(token->type != string_token || token->text_length != strlen("ifj24.zig") || memcmp(token->text, "ifj24.zig", token->text_length) != 0){
+        diag_raise(lexer->diag, 2, "Syntax error 70");
     }
-    token = get_token();
-    if(token->type == eof_token || strcmp(token->data, ")") != 0){
-        fprintf(stderr, "Syntax error 71\n");
-        exit(2);
+    token = get_token(lexer);
+    if(token->kind != kind_right_paren){
+        diag_raise(lexer->diag, 2, "Syntax error 71");
     }
-    token = get_token();
-    if(token->type == eof_token || strcmp(token->data, ";") != 0){
-        fprintf(stderr, "Syntax error 72\n");
-        exit(2);
+    token = get_token(lexer);
+    if(token->kind != kind_semicolon){
+        diag_raise(lexer->diag, 2, "Syntax error 72");
     }
     // First token after prolog
-    token = get_token();
-    create_node(token, ast);
-
-    code(token, ast);
-
-    semantic_analysis(ast);
-
-    ast->active = NULL;
-    generate_code(ast);
+    token = get_token(lexer);
 
-    destroy_ast(ast);
-
-    // printf("Syntax OK\n");
-
-    return 0;
-}
\ No newline at end of file
+    code(token, lexer, ast);
+}
@@ -0,0 +1,114 @@
+/*
+* Project: Implementacia prekladaca imperativneho jazyka IFJ2024
+*
+* @author: Jakub Hrdlicka <xhrdli18>
+*
+*/
+
+// Micro-benchmark of symtable insert and lookup with identifiers typical of generated code
+// usage: bench_hashtable [count] [rounds]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <setjmp.h>
+#include <time.h>
+#include "../diag.h"
+#include "../arena.h"
+#include "../intern.h"
+#include "../hashtable.h"
+
+// Lookups done for every inserted item
+#define LOOKUPS_PER_INSERT 10
+
+double now(void){
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return time.tv_sec + time.tv_nsec * 1e-9;
+}
+
+// Interns count names in the styles of generated code, similar names (tmp_12/tmp_21, x1/1x) included
+void generate_names(intern_table_t *intern, int *ids, int count){
+    char name[64];
+    for (int i = 0; i < count; i++){
+        switch (i % 4){
+            case 0:  snprintf(name, sizeof(name), "tmp_%d", i); break;
+            case 1:  snprintf(name, sizeof(name), "x%d", i); break;
+            case 2:  snprintf(name, sizeof(name), "counter_%d_value", i); break;
+            default: snprintf(name, sizeof(name), "v%dx", i); break;
+        }
+        ids[i] = intern_string(intern, name);
+    }
+}
+
+int main(int argc, char *argv[]){
+    int count = argc > 1 ? atoi(argv[1]) : 10000;
+    int rounds = argc > 2 ? atoi(argv[2]) : 100;
+    if (count <= 0 || rounds <= 0){
+        fprintf(stderr, "Usage: %s [count] [rounds]\n", argv[0]);
+        return 99;
+    }
+
+    jmp_buf jump;
+    diag_t diag = {0};
+    diag.jump = &jump;
+    arena_t arena;
+    arena_init(&arena, &diag);
+    intern_table_t intern;
+    intern_init(&intern, &arena);
+
+    int *ids = (int *)malloc(count * sizeof(int));
+    if (ids == NULL){
+        fprintf(stderr, "Error: Allocation failed\n");
+        return 99;
+    }
+
+    if (setjmp(jump)){
+        fprintf(stderr, "%s\n", diag.message);
+        return diag.code;
+    }
+
+    generate_names(&intern, ids, count);
+
+    double insert_time = 0;
+    double lookup_time = 0;
+    long found = 0;
+    for (int round = 0; round < rounds; round++){
+        arena_t items;
+        arena_init(&items, &diag);
+        ht_table_t table;
+        ht_init(&table, 128, &items);
+
+        double start = now();
+        for (int i = 0; i < count; i++){
+            ht_item_t item = {0};
+            item.id = ids[i];
+            item.name = intern_text(&intern, ids[i]);
+            item.var_type = sym_const;
+            item.used = true;
+            item.modified = true;
+            ht_insert(&table, &item);
+        }
+        double inserted = now();
+        // Lookups in order different from insertion
+        for (int k = 0; k < LOOKUPS_PER_INSERT; k++){
+            for (int i = 0; i < count; i++){
+                found += ht_search(&table, ids[(i * 7919L + k) % count]) != NULL;
+            }
+        }
+        double looked_up = now();
+
+        insert_time += inserted - start;
+        lookup_time += looked_up - inserted;
+        ht_free(&table);
+        arena_free(&items);
+    }
+
+    printf("count %d: insert %.1f ns, lookup %.1f ns (found %ld)\n", count,
+           insert_time / rounds / count * 1e9, lookup_time / rounds / count / LOOKUPS_PER_INSERT * 1e9, found);
+
+    free(ids);
+    intern_free(&intern);
+    arena_free(&arena);
+    return 0;
+}
@@ -0,0 +1,8 @@
+#!/bin/sh
+# Constant folding check: stack code of tests/fold.ifj is compared with tests/fold.expected
+# usage: tests/fold.sh [compiler]
+COMPILER=${1:-./test}
+DIR=$(dirname "$0")
+
+"$COMPILER" < "$DIR/fold.ifj" | grep -E '^(PUSHS|POPS|IDIVS)' | grep -v '@__' | diff -u "$DIR/fold.expected" - || exit 1
+echo "fold: OK"
@@ -0,0 +1,14 @@
+#!/bin/sh
+# Generates main with given number of assignment statements (default 1000000) to standard output
+# usage: tests/gen_statements.sh [count]
+COUNT=${1:-1000000}
+
+awk -v count="$COUNT" 'BEGIN {
+    print "const ifj = @import(\"ifj24.zig\");"
+    print ""
+    print "pub fn main() void {"
+    print "    var x: i32 = 0;"
+    for (i = 0; i < count; i++) print "    x = x + 1;"
+    print "    ifj.write(x);"
+    print "}"
+}'
@@ -8,6 +8,9 @@
 #ifndef TOKEN_H
 #define TOKEN_H
 
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
 
 typedef enum token_type {
     identifier_token,
@@ -31,9 +34,64 @@ typedef enum token_type {
 } token_type_t;
 
 
+// Fine-grained kind of token, keywords (recognized by kw_check) come first
+typedef enum token_kind {
+    kind_none,              // identifiers, literals, end of file
+    kind_const,
+    kind_else,
+    kind_fn,
+    kind_if,
+    kind_pub,
+    kind_return,
+    kind_var,
+    kind_void,
+    kind_while,
+    kind_i32,
+    kind_f64,
+    kind_null,
+    kind_nullable_i32,      // ?i32
+    kind_nullable_f64,      // ?f64
+    kind_string_type,       // []u8
+    kind_nullable_string_type,  // ?[]u8
+    kind_import,            // @import
+    kind_left_paren,        // (
+    kind_right_paren,       // )
+    kind_left_brace,        // {
+    kind_right_brace,       // }
+    kind_semicolon,         // ;
+    kind_colon,             // :
+    kind_comma,             // ,
+    kind_dot,               // .
+    kind_pipe,              // |
+    kind_assign,            // =
+    kind_plus,              // +
+    kind_minus,             // -
+    kind_multiply,          // *
+    kind_divide,            // /
+    kind_equal,             // ==
+    kind_not_equal,         // !=
+    kind_less,              // <
+    kind_greater,           // >
+    kind_less_equal,        // <=
+    kind_greater_equal      // >=
+} token_kind_t;
+
+
 typedef struct token{
-    char *data;
+    char *data;         // text of token, static spelling or interned name, NULL for int, float and string literals
     token_type_t type;
+    token_kind_t kind;  // exact kind of token
+    size_t offset;      // start of token in source
+    size_t length;      // length of token in source
+    int id;             // id of interned identifier, INTERN_NONE for other tokens
+    union {
+        int64_t int_value;  // value of int literal, parsed by lexer
+        double float_value; // value of float literal, parsed by lexer
+        struct {
+            const char *text;   // text of string literal, not NUL terminated, viewed in source or copied when it has escapes
+            size_t text_length;
+        };
+    };
 }token_t;
 
 